@@ -37,7 +37,9 @@ template <typename C, typename T, typename = void>
 struct apply_result { };
 
 template <typename C, typename T>
-struct apply_result<C, T, void_t<std::enable_if_t<is_tuple<T>::value>>> {
+struct apply_result<C, T, void_t<std::enable_if_t<
+    is_tuple<T>::value && is_applicable<C, T>::value
+>>> {
     using type = typename decltype(detail::check_apply_result(
         std::declval<C>(),
         std::declval<T>(),
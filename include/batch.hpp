@@ -0,0 +1,46 @@
+#ifndef UMIGV_RANGES_BATCH_HPP
+#define UMIGV_RANGES_BATCH_HPP
+
+#include "detail/batch.hpp"
+
+#include "traits.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace umigv {
+namespace ranges {
+
+// reads a range a block at a time. each call to next_batch assigns up to
+// capacity elements to the front of buffer, which must already hold that
+// many elements, and returns how many it wrote; zero means the range is
+// exhausted. adaptors that know how run their whole stage over the block
+template <typename I, typename S = I>
+class BatchReader {
+public:
+    using value_type = iterator_value_t<I>;
+
+    constexpr BatchReader(const I &first, const S &last)
+    noexcept(std::is_nothrow_copy_constructible<I>::value
+             && std::is_nothrow_copy_constructible<S>::value)
+    : first_{ first }, last_{ last } { }
+
+    std::size_t next_batch(value_type *buffer, std::size_t capacity) {
+        return detail::do_next_batch(first_, last_, buffer, capacity);
+    }
+
+    template <std::size_t N>
+    std::size_t next_batch(std::array<value_type, N> &buffer) {
+        return next_batch(buffer.data(), N);
+    }
+
+private:
+    I first_;
+    S last_;
+};
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef UMIGV_RANGES_CHECK_POLICY_HPP
+#define UMIGV_RANGES_CHECK_POLICY_HPP
+
+#include "traits.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+
+// the policy used by adaptors that are not given one. DefaultChecks names a
+// different type when this is changed, and inline functions that use it
+// (including every default template argument) would then be defined
+// differently in different translation units, which violates the ODR. if it
+// is set at all, it must be set to the same policy in every translation unit
+// of a program, e.g. from the build system. the same goes for NDEBUG when
+// AssertingChecks is the policy. pipelines that need a different policy
+// should name it explicitly with adapt<Policy> or range<Policy>
+#ifndef UMIGV_RANGES_CHECK_POLICY
+#define UMIGV_RANGES_CHECK_POLICY ::umigv::ranges::ThrowingChecks
+#endif
+
+namespace umigv {
+namespace ranges {
+
+struct ThrowingChecks {
+    static constexpr bool enabled = true;
+
+    [[noreturn]] static void fail(const char *what) {
+        throw std::out_of_range{ what };
+    }
+};
+
+struct AssertingChecks {
+#ifdef NDEBUG
+    static constexpr bool enabled = false;
+#else
+    static constexpr bool enabled = true;
+#endif
+
+    [[noreturn]] static void fail(const char *what) noexcept {
+        std::fprintf(stderr, "umigv::ranges: check failed in %s\n", what);
+        std::abort();
+    }
+};
+
+struct NoChecks {
+    static constexpr bool enabled = false;
+
+    static void fail(const char*) noexcept { }
+};
+
+using DefaultChecks = UMIGV_RANGES_CHECK_POLICY;
+
+template <typename C, typename = void>
+struct is_check_policy : std::false_type { };
+
+template <typename C>
+struct is_check_policy<C, void_t<
+    std::enable_if_t<std::is_same<decltype(C::enabled), const bool>::value>,
+    decltype(C::fail(""))
+>> : std::true_type { };
+
+template <typename R, typename = void>
+struct range_check_policy {
+    using type = DefaultChecks;
+};
+
+template <typename R>
+struct range_check_policy<R, void_t<typename remove_cvref_t<R>::check_policy>> {
+    using type = typename remove_cvref_t<R>::check_policy;
+};
+
+template <typename R>
+using range_check_policy_t = typename range_check_policy<R>::type;
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -1,6 +1,11 @@
 #ifndef UMIGV_RANGES_COLLECT_HPP
 #define UMIGV_RANGES_COLLECT_HPP
 
+#include "detail/collect.hpp"
+#include "detail/fold.hpp"
+
+#include "size_hint.hpp"
+
 #include <type_traits>
 
 namespace umigv {
@@ -9,19 +14,55 @@ namespace ranges {
 template <typename I>
 class Collectable {
 public:
-    constexpr Collectable(const I &first, const I &last)
+    constexpr Collectable(const I &first, const I &last,
+                          const SizeHint &hint = SizeHint::unknown())
     noexcept(std::is_nothrow_copy_constructible<I>::value)
-    : first_{ first }, last_{ last } { }
+    : first_{ first }, last_{ last }, hint_{ hint } { }
 
     template <typename C,
-              std::enable_if_t<std::is_constructible<C, I, I>::value, int> = 0>
+              std::enable_if_t<
+                  std::is_constructible<C, I, I>::value
+                  && !detail::is_reserve_collectable<C, I>::value
+                  && !detail::is_memcpy_collectable<C, I, I>::value,
+                  int
+              > = 0>
     constexpr operator C() const {
         return C(first_, last_);
     }
 
+    // constructing from pointers lets the container copy the elements with
+    // memcpy, which most standard library implementations do
+    template <typename C,
+              std::enable_if_t<
+                  std::is_constructible<C, I, I>::value
+                  && detail::is_memcpy_collectable<C, I, I>::value,
+                  int
+              > = 0>
+    operator C() const {
+        const iterator_value_t<I> *const data =
+            detail::contiguous_data(first_, last_);
+
+        return C(data, data + (last_ - first_));
+    }
+
+    template <typename C,
+              std::enable_if_t<
+                  std::is_constructible<C, I, I>::value
+                  && detail::is_reserve_collectable<C, I>::value,
+                  int
+              > = 0>
+    constexpr operator C() const {
+        C collected;
+        detail::do_extend(collected, first_, last_, hint_);
+        detail::do_trim<I>(collected);
+
+        return collected;
+    }
+
 private:
     I first_;
     I last_;
+    SizeHint hint_;
 };
 
 } // namespae ranges
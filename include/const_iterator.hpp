@@ -18,8 +18,8 @@ public:
     using difference_type = iterator_difference_t<I>;
     using value_type = iterator_value_t<I>;
     using pointer = const std::remove_pointer_t<iterator_pointer_t<I>>*;
-    using reference = const iterator_reference_t<I>;
-    using iterator_category = std::input_iterator_tag;
+    using reference = add_const_reference_t<iterator_reference_t<I>>;
+    using iterator_category = clamped_iterator_category_t<I>;
 
     constexpr explicit ConstIterator(const I &base)
     noexcept(std::is_nothrow_copy_constructible<I>::value) : base_{ base } { }
@@ -46,6 +46,102 @@ public:
         return to_return;
     }
 
+    template <typename J = I,
+              std::enable_if_t<is_bidirectional_iterator<J>::value, int> = 0>
+    constexpr ConstIterator& operator--() {
+        --base_;
+
+        return *this;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_bidirectional_iterator<J>::value, int> = 0>
+    constexpr ConstIterator operator--(int) {
+        const ConstIterator to_return = *this;
+
+        --*this;
+
+        return to_return;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr ConstIterator& operator+=(difference_type n) {
+        base_ += n;
+
+        return *this;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr ConstIterator& operator-=(difference_type n) {
+        base_ -= n;
+
+        return *this;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr reference operator[](difference_type n) const {
+        return base_[n];
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr ConstIterator operator+(ConstIterator iter,
+                                             difference_type n) {
+        return iter += n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr ConstIterator operator+(difference_type n,
+                                             ConstIterator iter) {
+        return iter += n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr ConstIterator operator-(ConstIterator iter,
+                                             difference_type n) {
+        return iter -= n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr difference_type operator-(const ConstIterator &lhs,
+                                               const ConstIterator &rhs) {
+        return lhs.base_ - rhs.base_;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator<(const ConstIterator &lhs,
+                                    const ConstIterator &rhs) {
+        return lhs.base_ < rhs.base_;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator>(const ConstIterator &lhs,
+                                    const ConstIterator &rhs) {
+        return rhs < lhs;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator<=(const ConstIterator &lhs,
+                                     const ConstIterator &rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator>=(const ConstIterator &lhs,
+                                     const ConstIterator &rhs) {
+        return !(lhs < rhs);
+    }
+
     friend constexpr bool operator==(const ConstIterator &lhs,
                                      const ConstIterator &rhs)
     noexcept(is_nothrow_equality_comparable<I>::value) {
@@ -62,6 +158,11 @@ private:
     I base_;
 };
 
+// adding const does not move the elements
+template <typename I>
+struct is_contiguous_iterator<ConstIterator<I>, true>
+: is_contiguous_iterator<I> { };
+
 } // namespace ranges
 } // namespace umigv
 
@@ -0,0 +1,53 @@
+#ifndef UMIGV_RANGES_CONTROL_FLOW_HPP
+#define UMIGV_RANGES_CONTROL_FLOW_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+
+// returned by the function passed to Range::try_fold; stop ends the fold
+// early with the given value, proceed moves on to the next element
+template <typename T>
+class ControlFlow {
+public:
+    constexpr static ControlFlow proceed(T value)
+    noexcept(std::is_nothrow_move_constructible<T>::value) {
+        return { std::move(value), false };
+    }
+
+    constexpr static ControlFlow stop(T value)
+    noexcept(std::is_nothrow_move_constructible<T>::value) {
+        return { std::move(value), true };
+    }
+
+    constexpr bool is_stop() const noexcept {
+        return is_stop_;
+    }
+
+    constexpr T& value() & noexcept {
+        return value_;
+    }
+
+    constexpr const T& value() const & noexcept {
+        return value_;
+    }
+
+    constexpr T&& value() && noexcept {
+        return std::move(value_);
+    }
+
+private:
+    constexpr ControlFlow(T value, bool is_stop)
+    noexcept(std::is_nothrow_move_constructible<T>::value)
+    : value_(std::move(value)), is_stop_{ is_stop } { }
+
+    T value_;
+    bool is_stop_;
+};
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -1,43 +1,124 @@
 #ifndef UMIGV_RANGES_COUNTING_RANGE_HPP
 #define UMIGV_RANGES_COUNTING_RANGE_HPP
 
+#include "detail/check_policy.hpp"
+#include "detail/fold.hpp"
+#include "detail/sentinel.hpp"
+
+#include "check_policy.hpp"
+#include "control_flow.hpp"
 #include "range_fwd.hpp"
+#include "sentinel.hpp"
 #include "traits.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace umigv {
 namespace ranges {
+namespace detail {
 
-template <typename T>
+template <typename T, std::enable_if_t<std::is_signed<T>::value, int> = 0>
+constexpr bool is_negative(const T &t) noexcept {
+    return t < T{ 0 };
+}
+
+template <typename T, std::enable_if_t<!std::is_signed<T>::value, int> = 0>
+constexpr bool is_negative(const T&) noexcept {
+    return false;
+}
+
+// distances are taken in the unsigned type, where they cannot overflow even
+// when the range spans every value of T or step is close to its limit
+template <typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+constexpr std::ptrdiff_t counting_size(const T &begin, const T &step,
+                                       const T &end) noexcept {
+    using UnsignedT = std::make_unsigned_t<T>;
+
+    const bool is_descending = is_negative(step);
+
+    if (is_descending ? !(begin > end) : !(end > begin)) {
+        return 0;
+    }
+
+    const auto distance = is_descending
+        ? static_cast<UnsignedT>(static_cast<UnsignedT>(begin)
+                                 - static_cast<UnsignedT>(end))
+        : static_cast<UnsignedT>(static_cast<UnsignedT>(end)
+                                 - static_cast<UnsignedT>(begin));
+    const auto stride = is_descending
+        ? static_cast<UnsignedT>(UnsignedT{ 0 } - static_cast<UnsignedT>(step))
+        : static_cast<UnsignedT>(step);
+
+    return static_cast<std::ptrdiff_t>(distance / stride
+                                       + ((distance % stride != 0) ? 1 : 0));
+}
+
+template <typename T, std::enable_if_t<!std::is_integral<T>::value, int> = 0>
+constexpr std::ptrdiff_t counting_size(const T &begin, const T &step,
+                                       const T &end) {
+    using std::ceil;
+
+    const auto size = ceil((end - begin) / step);
+
+    return (size > 0) ? static_cast<std::ptrdiff_t>(size) : 0;
+}
+
+// the element at index, which always fits in T; integers are computed with
+// wrapping unsigned arithmetic so the intermediate product cannot overflow
+template <typename T, std::enable_if_t<std::is_integral<T>::value, int> = 0>
+constexpr T counting_value(const T &begin, const T &step,
+                           std::ptrdiff_t index) noexcept {
+    // at least unsigned int, so that small types are not promoted to int
+    using UnsignedT =
+        std::common_type_t<std::make_unsigned_t<T>, unsigned int>;
+
+    return static_cast<T>(
+        static_cast<UnsignedT>(begin)
+        + static_cast<UnsignedT>(index) * static_cast<UnsignedT>(step)
+    );
+}
+
+template <typename T, std::enable_if_t<!std::is_integral<T>::value, int> = 0>
+constexpr T counting_value(const T &begin, const T &step,
+                           std::ptrdiff_t index) {
+    return static_cast<T>(begin + static_cast<T>(index) * step);
+}
+
+} // namespace detail
+
+template <typename T, typename C = DefaultChecks>
 class CountingRange;
 
-template <typename T>
-class CountingRangeIterator {
+template <typename T, typename C = DefaultChecks>
+class CountingRangeIterator
+: private detail::CheckedBound<std::ptrdiff_t, C::enabled> {
+    using BoundT = detail::CheckedBound<std::ptrdiff_t, C::enabled>;
+
 public:
     using difference_type = std::ptrdiff_t;
-    using iterator_category = std::input_iterator_tag;
-    using pointer = const T*;
-    using reference = const T&;
+    using iterator_category = std::random_access_iterator_tag;
+    using pointer = void;
+    using reference = T;
     using value_type = T;
 
-    friend CountingRange<T>;
+    friend CountingRange<T, C>;
 
     constexpr reference operator*() const {
         range_check("CountingRangeIterator::operator*");
 
-        return current_;
-    }
-
-    constexpr pointer operator->() const noexcept {
-        return std::addressof(**this);
+        return value_at(index_);
     }
 
     constexpr CountingRangeIterator& operator++() {
         range_check("CountingRangeIterator::operator++");
 
-        current_ += step_;
+        ++index_;
 
         return *this;
     }
@@ -50,13 +131,69 @@ public:
         return to_return;
     }
 
+    constexpr CountingRangeIterator& operator--() {
+        if (C::enabled && index_ == 0) {
+            C::fail("CountingRangeIterator::operator--");
+        }
+
+        --index_;
+
+        return *this;
+    }
+
+    constexpr CountingRangeIterator operator--(int) {
+        const auto to_return = *this;
+
+        --(*this);
+
+        return to_return;
+    }
+
+    constexpr CountingRangeIterator& operator+=(difference_type n) {
+        if (C::enabled && (index_ + n < 0 || n > bound().remaining(index_))) {
+            C::fail("CountingRangeIterator::operator+=");
+        }
+
+        index_ += n;
+
+        return *this;
+    }
+
+    constexpr CountingRangeIterator& operator-=(difference_type n) {
+        return *this += -n;
+    }
+
+    constexpr reference operator[](difference_type n) const {
+        return *(*this + n);
+    }
+
+    friend constexpr CountingRangeIterator operator+(CountingRangeIterator iter,
+                                                     difference_type n) {
+        return iter += n;
+    }
+
+    friend constexpr CountingRangeIterator operator+(difference_type n,
+                                                     CountingRangeIterator iter) {
+        return iter += n;
+    }
+
+    friend constexpr CountingRangeIterator operator-(CountingRangeIterator iter,
+                                                     difference_type n) {
+        return iter -= n;
+    }
+
+    friend constexpr difference_type operator-(const CountingRangeIterator &lhs,
+                                               const CountingRangeIterator &rhs) {
+        compatibility_check(lhs, rhs, "CountingRangeIterator::operator-");
+
+        return lhs.index_ - rhs.index_;
+    }
+
     friend constexpr bool operator==(const CountingRangeIterator &lhs,
                                      const CountingRangeIterator &rhs) {
-        if (lhs.step_ != rhs.step_ || lhs.end_ != rhs.end_) {
-            throw std::out_of_range{ "CountingRangeIterator::operator==" };
-        }
+        compatibility_check(lhs, rhs, "CountingRangeIterator::operator==");
 
-        return lhs.current_ == rhs.current_;
+        return lhs.index_ == rhs.index_;
     }
 
     friend constexpr bool operator!=(const CountingRangeIterator &lhs,
@@ -64,82 +201,271 @@ public:
         return !(lhs == rhs);
     }
 
+    friend constexpr bool operator==(const CountingRangeIterator &lhs,
+                                     const Sentinel<difference_type> &rhs) {
+        return lhs.index_ == rhs.base();
+    }
+
+    friend constexpr bool operator==(const Sentinel<difference_type> &lhs,
+                                     const CountingRangeIterator &rhs) {
+        return rhs == lhs;
+    }
+
+    friend constexpr bool operator!=(const CountingRangeIterator &lhs,
+                                     const Sentinel<difference_type> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator!=(const Sentinel<difference_type> &lhs,
+                                     const CountingRangeIterator &rhs) {
+        return !(rhs == lhs);
+    }
+
+    friend constexpr bool operator<(const CountingRangeIterator &lhs,
+                                    const CountingRangeIterator &rhs) {
+        compatibility_check(lhs, rhs, "CountingRangeIterator::operator<");
+
+        return lhs.index_ < rhs.index_;
+    }
+
+    friend constexpr bool operator>(const CountingRangeIterator &lhs,
+                                    const CountingRangeIterator &rhs) {
+        return rhs < lhs;
+    }
+
+    friend constexpr bool operator<=(const CountingRangeIterator &lhs,
+                                     const CountingRangeIterator &rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend constexpr bool operator>=(const CountingRangeIterator &lhs,
+                                     const CountingRangeIterator &rhs) {
+        return !(lhs < rhs);
+    }
+
+    template <typename S, typename A, typename G,
+              std::enable_if_t<
+                  detail::is_end_of<
+                      S, difference_type, CountingRangeIterator
+                  >::value,
+                  int
+              > = 0>
+    friend constexpr ControlFlow<A> try_fold(const CountingRangeIterator &first,
+                                             const S &last, A init, G &g) {
+        const difference_type end = end_index(last);
+
+        for (auto index = first.index_; index < end; ++index) {
+            ControlFlow<A> flow = g(std::move(init), first.value_at(index));
+
+            if (flow.is_stop()) {
+                return flow;
+            }
+
+            init = std::move(flow).value();
+        }
+
+        return ControlFlow<A>::proceed(std::move(init));
+    }
+
+    template <typename S,
+              std::enable_if_t<
+                  detail::is_end_of<
+                      S, difference_type, CountingRangeIterator
+                  >::value,
+                  int
+              > = 0>
+    friend constexpr difference_type
+    sized_distance(const CountingRangeIterator &first, const S &last) {
+        return end_index(last) - first.index_;
+    }
+
+    template <typename S,
+              std::enable_if_t<
+                  detail::is_end_of<
+                      S, difference_type, CountingRangeIterator
+                  >::value,
+                  int
+              > = 0>
+    friend std::size_t next_batch(CountingRangeIterator &first,
+                                  const S &last, value_type *out,
+                                  std::size_t capacity) {
+        const auto count = std::min(
+            capacity, static_cast<std::size_t>(end_index(last) - first.index_)
+        );
+        const difference_type index = first.index_;
+
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = first.value_at(index + static_cast<difference_type>(i));
+        }
+
+        first.index_ += static_cast<difference_type>(count);
+
+        return count;
+    }
+
 private:
-    constexpr CountingRangeIterator(const T &current, const T &step,
-                                    const T &end) noexcept
-    : current_{ current }, step_{ step }, end_{ end } { }
-
-    template <std::size_t N>
-    constexpr void range_check(const char (&what)[N]) const {
-        if (step_ > 0 && current_ >= end_) {
-            throw std::out_of_range{ what };
-        } else if (step_ < 0 && current_ <= end_) {
-            throw std::out_of_range{ what };
+    constexpr static difference_type
+    end_index(const Sentinel<difference_type> &last) noexcept {
+        return last.base();
+    }
+
+    constexpr static difference_type
+    end_index(const CountingRangeIterator &last) noexcept {
+        return last.index_;
+    }
+
+    constexpr CountingRangeIterator(const T &first, const T &step,
+                                    difference_type index,
+                                    difference_type size) noexcept
+    : BoundT{ size }, first_{ first }, step_{ step }, index_{ index } { }
+
+    constexpr const BoundT& bound() const noexcept {
+        return *this;
+    }
+
+    constexpr T value_at(difference_type index) const noexcept {
+        return detail::counting_value(first_, step_, index);
+    }
+
+    constexpr void range_check(const char *what) const {
+        if (C::enabled && bound().is_end(index_)) {
+            C::fail(what);
+        }
+    }
+
+    constexpr static void compatibility_check(const CountingRangeIterator &lhs,
+                                              const CountingRangeIterator &rhs,
+                                              const char *what) {
+        if (C::enabled && (lhs.step_ != rhs.step_
+                           || !lhs.bound().is_compatible(rhs.bound()))) {
+            C::fail(what);
         }
     }
 
-    T current_ = 0;
-    T step_ = 1;
-    T end_;
+    T first_;
+    T step_;
+    difference_type index_;
 };
 
-template <typename T>
-class CountingRange : public Range<CountingRange<T>> {
+template <typename T, typename C>
+class CountingRange : public Range<CountingRange<T, C>> {
 public:
+    using check_policy = typename RangeTraits<CountingRange>::check_policy;
     using difference_type =
         typename RangeTraits<CountingRange>::difference_type;
     using iterator = typename RangeTraits<CountingRange>::iterator;
     using pointer = typename RangeTraits<CountingRange>::pointer;
     using reference = typename RangeTraits<CountingRange>::reference;
+    using sentinel = typename RangeTraits<CountingRange>::sentinel;
     using value_type = typename RangeTraits<CountingRange>::value_type;
 
-    constexpr explicit CountingRange(const T &end) noexcept : end_{ end } { }
+    constexpr explicit CountingRange(const T &end)
+    : CountingRange{ T{ 0 }, T{ 1 }, end } { }
 
-    constexpr CountingRange(const T &begin, const T &end) noexcept
-    : begin_{ begin }, end_{ end } { }
+    constexpr CountingRange(const T &begin, const T &end)
+    : CountingRange{ begin, T{ 1 }, end } { }
 
-    constexpr CountingRange(const T &begin, const T &step,
-                            const T &end) noexcept
-    : begin_{ begin }, step_{ step },
-      end_{ begin + step * (end - begin) / step } { }
+    constexpr CountingRange(const T &begin, const T &step, const T &end)
+    : begin_{ begin }, step_{ step }, first_{ 0 },
+      last_{ detail::counting_size(begin, checked_step(step), end) } { }
+
+    constexpr iterator begin() const noexcept {
+        return { begin_, step_, first_, last_ };
+    }
+
+    constexpr iterator end() const noexcept {
+        return { begin_, step_, last_, last_ };
+    }
+
+    constexpr sentinel end_sentinel() const noexcept {
+        return sentinel{ last_ };
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return static_cast<std::size_t>(last_ - first_);
+    }
 
-    constexpr CountingRangeIterator<T> begin() const noexcept {
-        return { begin_, step_, end_ };
+    // the halves keep counting from the same origin, so the values of the
+    // second half are computed exactly as they would be without the split
+    constexpr std::pair<CountingRange, CountingRange>
+    split_at(difference_type n) const {
+        if (C::enabled && (n < 0 || n > last_ - first_)) {
+            C::fail("CountingRange::split_at");
+        }
+
+        return { CountingRange{ begin_, step_, first_, first_ + n },
+                 CountingRange{ begin_, step_, first_ + n, last_ } };
     }
 
-    constexpr CountingRangeIterator<T> end() const noexcept {
-        return { end_, step_, end_ };
+    constexpr std::pair<CountingRange, CountingRange> split() const {
+        return split_at((last_ - first_) / 2);
     }
 
 private:
-    T begin_ = 0;
-    T step_ = 1;
-    T end_;
+    constexpr CountingRange(const T &begin, const T &step,
+                            difference_type first,
+                            difference_type last) noexcept
+    : begin_{ begin }, step_{ step }, first_{ first }, last_{ last } { }
+
+    constexpr static const T& checked_step(const T &step) {
+        if (step == T{ 0 }) {
+            throw std::invalid_argument{ "CountingRange::CountingRange" };
+        }
+
+        return step;
+    }
+
+    T begin_;
+    T step_;
+    difference_type first_;
+    difference_type last_;
 };
 
 template <typename T>
-constexpr CountingRange<T> range(const T &end) noexcept {
+constexpr CountingRange<T> range(const T &end) {
     return CountingRange<T>{ end };
 }
 
 template <typename T>
-constexpr CountingRange<T> range(const T &begin, const T &end) noexcept {
+constexpr CountingRange<T> range(const T &begin, const T &end) {
     return CountingRange<T>{ begin, end };
 }
 
 template <typename T>
 constexpr CountingRange<T> range(const T &begin, const T &step,
-                                 const T &end) noexcept {
+                                 const T &end) {
     return CountingRange<T>{ begin, step, end };
 }
 
-template <typename T>
-struct RangeTraits<CountingRange<T>> {
-    using difference_type = iterator_difference_t<CountingRangeIterator<T>>;
-    using iterator = CountingRangeIterator<T>;
-    using pointer = iterator_pointer_t<CountingRangeIterator<T>>;
-    using reference = iterator_reference_t<CountingRangeIterator<T>>;
-    using value_type = iterator_value_t<CountingRangeIterator<T>>;
+template <typename C, typename T,
+          std::enable_if_t<is_check_policy<C>::value, int> = 0>
+constexpr CountingRange<T, C> range(const T &end) {
+    return CountingRange<T, C>{ end };
+}
+
+template <typename C, typename T,
+          std::enable_if_t<is_check_policy<C>::value, int> = 0>
+constexpr CountingRange<T, C> range(const T &begin, const T &end) {
+    return CountingRange<T, C>{ begin, end };
+}
+
+template <typename C, typename T,
+          std::enable_if_t<is_check_policy<C>::value, int> = 0>
+constexpr CountingRange<T, C> range(const T &begin, const T &step,
+                                    const T &end) {
+    return CountingRange<T, C>{ begin, step, end };
+}
+
+template <typename T, typename C>
+struct RangeTraits<CountingRange<T, C>> {
+    using check_policy = C;
+    using difference_type =
+        iterator_difference_t<CountingRangeIterator<T, C>>;
+    using iterator = CountingRangeIterator<T, C>;
+    using pointer = iterator_pointer_t<CountingRangeIterator<T, C>>;
+    using reference = iterator_reference_t<CountingRangeIterator<T, C>>;
+    using sentinel = Sentinel<difference_type>;
+    using value_type = iterator_value_t<CountingRangeIterator<T, C>>;
 };
 
 } // namespace ranges
@@ -0,0 +1,120 @@
+#ifndef UMIGV_RANGES_DETAIL_BATCH_HPP
+#define UMIGV_RANGES_DETAIL_BATCH_HPP
+
+#include "filtered_range.hpp"
+#include "fold.hpp"
+#include "size_hint.hpp"
+
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+// the largest block an adaptor stages or tests at once
+constexpr std::size_t BATCH_SIZE = 256;
+
+template <typename I, typename S, typename T>
+auto do_next_batch(I &first, const S &last, T *out, std::size_t capacity,
+                   PriorityTag<2>)
+-> decltype(next_batch(first, last, out, capacity)) {
+    return next_batch(first, last, out, capacity);
+}
+
+// when the number of remaining elements is known up front the copy loop
+// needs no end test
+template <typename I, typename S, typename T,
+          std::enable_if_t<
+              is_random_access_iterator<I>::value && is_sized<I, S>::value,
+              int
+          > = 0>
+std::size_t do_next_batch(I &first, const S &last, T *out,
+                          std::size_t capacity, PriorityTag<1>) {
+    const std::size_t count = std::min(
+        capacity, static_cast<std::size_t>(do_sized_distance(first, last))
+    );
+
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = first[static_cast<iterator_difference_t<I>>(i)];
+    }
+
+    first += static_cast<iterator_difference_t<I>>(count);
+
+    return count;
+}
+
+template <typename I, typename S, typename T>
+std::size_t do_next_batch(I &first, const S &last, T *out,
+                          std::size_t capacity, PriorityTag<0>) {
+    std::size_t count = 0;
+
+    for (; count < capacity && !(first == last); ++first, ++count) {
+        out[count] = *first;
+    }
+
+    return count;
+}
+
+// assigns up to capacity elements of [first, last) to out, advances first
+// past them and returns how many were written. adaptor iterators provide a
+// hidden friend next_batch that works a block at a time
+template <typename I, typename S, typename T>
+std::size_t do_next_batch(I &first, const S &last, T *out,
+                          std::size_t capacity) {
+    return do_next_batch(first, last, out, capacity, PriorityTag<2>{ });
+}
+
+template <typename T, typename P>
+struct is_batch_testable
+: disjunction<is_invoke_testable<T, P>, is_apply_testable<T, P>> { };
+
+// arithmetic elements are cheap to copy, so every element is stored to the
+// next free slot and the slot is only kept if the predicate passes. there is
+// no branch on the predicate, which lets the loop vectorize
+template <typename T, typename P,
+          std::enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+std::size_t compact(T *values, std::size_t count, const P &predicate) {
+    std::size_t num_selected = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const T value = values[i];
+
+        values[num_selected] = value;
+        num_selected += test(predicate, value) ? 1 : 0;
+    }
+
+    return num_selected;
+}
+
+// the predicate is run over the whole block before anything moves, which
+// keeps the testing loop free of data dependent stores
+template <typename T, typename P,
+          std::enable_if_t<!std::is_arithmetic<T>::value, int> = 0>
+std::size_t compact(T *values, std::size_t count, const P &predicate) {
+    std::size_t selection[BATCH_SIZE];
+    std::size_t num_selected = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        selection[num_selected] = i;
+        num_selected += test(predicate, values[i]) ? 1 : 0;
+    }
+
+    for (std::size_t i = 0; i < num_selected; ++i) {
+        if (selection[i] != i) {
+            values[i] = std::move(values[selection[i]]);
+        }
+    }
+
+    return num_selected;
+}
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
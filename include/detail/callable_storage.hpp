@@ -0,0 +1,136 @@
+#ifndef UMIGV_RANGES_DETAIL_CALLABLE_STORAGE_HPP
+#define UMIGV_RANGES_DETAIL_CALLABLE_STORAGE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+template <typename F>
+struct is_compressible
+: std::integral_constant<
+    bool,
+    std::is_empty<F>::value && !std::is_final<F>::value
+> { };
+
+template <typename F>
+struct is_reconstruct_assignable
+: std::integral_constant<
+    bool,
+    !std::is_copy_assignable<F>::value
+    && std::is_nothrow_copy_constructible<F>::value
+> { };
+
+// closure types are not copy assignable, which would make every iterator
+// holding one unusable with algorithms that reassign iterators; when copying
+// cannot throw, assignment is emulated by destroying and copying in place.
+// stateless callables are stored as an empty base and take up no space
+template <typename F, bool = is_compressible<F>::value,
+          bool = is_reconstruct_assignable<F>::value>
+class CallableStorage {
+public:
+    constexpr explicit CallableStorage(const F &f)
+    noexcept(std::is_nothrow_copy_constructible<F>::value) : f_{ f } { }
+
+    constexpr const F& get() const noexcept {
+        return f_;
+    }
+
+private:
+    F f_;
+};
+
+template <typename F>
+class CallableStorage<F, false, true> {
+public:
+    constexpr explicit CallableStorage(const F &f) noexcept : f_{ f } { }
+
+    constexpr CallableStorage(const CallableStorage &other) noexcept = default;
+
+    CallableStorage& operator=(const CallableStorage &other) noexcept {
+        if (this != &other) {
+            f_.~F();
+            ::new (static_cast<void*>(std::addressof(f_))) F(other.f_);
+        }
+
+        return *this;
+    }
+
+    constexpr const F& get() const noexcept {
+        return f_;
+    }
+
+private:
+    F f_;
+};
+
+template <typename F>
+class CallableStorage<F, true, false> : private F {
+public:
+    constexpr explicit CallableStorage(const F &f)
+    noexcept(std::is_nothrow_copy_constructible<F>::value) : F(f) { }
+
+    constexpr const F& get() const noexcept {
+        return *this;
+    }
+};
+
+template <typename F>
+class CallableStorage<F, true, true> : private F {
+public:
+    constexpr explicit CallableStorage(const F &f) noexcept : F(f) { }
+
+    constexpr CallableStorage(const CallableStorage &other) noexcept = default;
+
+    CallableStorage& operator=(const CallableStorage&) noexcept {
+        return *this;
+    }
+
+    constexpr const F& get() const noexcept {
+        return *this;
+    }
+};
+
+// lets Owner hold several callables as empty bases, even when two of them
+// have the same type or are themselves owners of slots for the same callable
+template <typename F, typename Owner, std::size_t N>
+class CallableSlot : public CallableStorage<F> {
+public:
+    constexpr explicit CallableSlot(const F &f)
+    noexcept(std::is_nothrow_copy_constructible<F>::value)
+    : CallableStorage<F>{ f } { }
+};
+
+template <typename T, typename F>
+class CompressedPair : private CallableStorage<F> {
+public:
+    constexpr CompressedPair(const T &first, const F &second)
+    noexcept(std::is_nothrow_copy_constructible<T>::value
+             && std::is_nothrow_copy_constructible<F>::value)
+    : CallableStorage<F>{ second }, first_{ first } { }
+
+    constexpr T& first() noexcept {
+        return first_;
+    }
+
+    constexpr const T& first() const noexcept {
+        return first_;
+    }
+
+    constexpr const F& second() const noexcept {
+        return CallableStorage<F>::get();
+    }
+
+private:
+    T first_;
+};
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
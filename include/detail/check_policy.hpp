@@ -0,0 +1,111 @@
+#ifndef UMIGV_RANGES_DETAIL_CHECK_POLICY_HPP
+#define UMIGV_RANGES_DETAIL_CHECK_POLICY_HPP
+
+#include "../traits.hpp"
+
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+template <typename I, bool Enabled>
+class CheckedBound {
+public:
+    constexpr explicit CheckedBound(const I &last)
+    noexcept(std::is_nothrow_copy_constructible<I>::value) : last_{ last } { }
+
+    constexpr CheckedBound(const I&, const I &last)
+    noexcept(std::is_nothrow_copy_constructible<I>::value) : last_{ last } { }
+
+    constexpr bool is_end(const I &current) const {
+        return current == last_;
+    }
+
+    constexpr auto remaining(const I &current) const {
+        return last_ - current;
+    }
+
+    constexpr bool is_compatible(const CheckedBound &other) const {
+        return last_ == other.last_;
+    }
+
+private:
+    I last_;
+};
+
+template <typename I>
+class CheckedBound<I, false> {
+public:
+    constexpr explicit CheckedBound(const I&) noexcept { }
+
+    constexpr CheckedBound(const I&, const I&) noexcept { }
+
+    constexpr bool is_end(const I&) const noexcept {
+        return false;
+    }
+
+    template <typename J = I>
+    constexpr auto remaining(const J&) const noexcept {
+        using DifferenceT =
+            decltype(std::declval<const J&>() - std::declval<const J&>());
+
+        return std::numeric_limits<DifferenceT>::max();
+    }
+
+    constexpr bool is_compatible(const CheckedBound&) const noexcept {
+        return true;
+    }
+};
+
+// a bound on both ends, for iterators that can also move backwards
+template <typename I, bool Enabled>
+class CheckedInterval : public CheckedBound<I, Enabled> {
+public:
+    constexpr CheckedInterval(const I &first, const I &last)
+    noexcept(std::is_nothrow_copy_constructible<I>::value)
+    : CheckedBound<I, Enabled>{ last }, first_{ first } { }
+
+    constexpr bool is_begin(const I &current) const {
+        return current == first_;
+    }
+
+    constexpr auto preceding(const I &current) const {
+        return current - first_;
+    }
+
+private:
+    I first_;
+};
+
+template <typename I>
+class CheckedInterval<I, false> : public CheckedBound<I, false> {
+public:
+    constexpr CheckedInterval(const I &first, const I &last) noexcept
+    : CheckedBound<I, false>{ first, last } { }
+
+    constexpr bool is_begin(const I&) const noexcept {
+        return false;
+    }
+
+    template <typename J = I>
+    constexpr auto preceding(const J &current) const noexcept {
+        return this->remaining(current);
+    }
+};
+
+// only iterators that can move backwards pay for tracking where they start
+template <typename I, bool Enabled>
+using checked_bound_t = std::conditional_t<
+    is_bidirectional_iterator<I>::value,
+    CheckedInterval<I, Enabled>,
+    CheckedBound<I, Enabled>
+>;
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -0,0 +1,264 @@
+#ifndef UMIGV_RANGES_DETAIL_COLLECT_HPP
+#define UMIGV_RANGES_DETAIL_COLLECT_HPP
+
+#include "batch.hpp"
+#include "fold.hpp"
+
+#include "../control_flow.hpp"
+#include "../size_hint.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+template <typename C, typename I, typename = void>
+struct is_reservable : std::false_type { };
+
+template <typename C, typename I>
+struct is_reservable<C, I, void_t<
+    std::enable_if_t<std::is_default_constructible<C>::value>,
+    decltype(std::declval<C&>().reserve(std::declval<std::size_t>())),
+    decltype(std::declval<C&>().insert(std::declval<C&>().end(),
+                                       *std::declval<const I&>()))
+>> : std::true_type { };
+
+// forward iterators let the container measure the range itself, so only
+// single pass ranges are worth reserving for up front
+template <typename C, typename I>
+struct is_reserve_collectable
+: std::integral_constant<
+    bool,
+    !is_forward_iterator<I>::value && is_reservable<C, I>::value
+> { };
+
+// a vector of arithmetic elements can be filled a block at a time straight
+// into its own storage, which adaptors such as filter compact in place
+template <typename C, typename I>
+struct is_batch_collectable
+: std::integral_constant<
+    bool,
+    std::is_same<C, std::vector<iterator_value_t<I>>>::value
+    && std::is_arithmetic<iterator_value_t<I>>::value
+    && !std::is_same<iterator_value_t<I>, bool>::value
+> { };
+
+template <typename C>
+class InsertStep {
+public:
+    constexpr explicit InsertStep(C &container) noexcept
+    : container_(container) { }
+
+    template <typename U>
+    constexpr ControlFlow<Unit> operator()(Unit, U &&element) const {
+        container_.insert(container_.end(), std::forward<U>(element));
+
+        return ControlFlow<Unit>::proceed(Unit{ });
+    }
+
+private:
+    C &container_;
+};
+
+template <typename C, typename I, typename = void>
+struct is_extendable : std::false_type { };
+
+template <typename C, typename I>
+struct is_extendable<C, I, void_t<
+    decltype(std::declval<C&>().insert(std::declval<C&>().end(),
+                                       *std::declval<const I&>()))
+>> : std::true_type { };
+
+template <typename C, typename = void>
+struct is_extend_reservable : std::false_type { };
+
+template <typename C>
+struct is_extend_reservable<C, void_t<
+    decltype(std::declval<C&>().reserve(std::declval<C&>().size()))
+>> : std::true_type { };
+
+// contiguous elements that are trivially copyable can be copied as raw bytes
+template <typename I, typename S>
+struct is_memcpy_copyable
+: std::integral_constant<
+    bool,
+    is_contiguous_iterator<I>::value && is_sized<I, S>::value
+    && std::is_trivially_copyable<iterator_value_t<I>>::value
+> { };
+
+template <typename C, typename I, typename S>
+struct is_memcpy_collectable
+: std::integral_constant<
+    bool,
+    is_memcpy_copyable<I, S>::value
+    && std::is_constructible<C, const iterator_value_t<I>*,
+                             const iterator_value_t<I>*>::value
+> { };
+
+template <typename C, typename I, typename S>
+struct is_memcpy_extendable
+: std::integral_constant<
+    bool,
+    is_memcpy_copyable<I, S>::value
+    && std::is_same<C, std::vector<iterator_value_t<I>>>::value
+> { };
+
+template <typename T>
+struct is_std_array : std::false_type { };
+
+template <typename T, std::size_t N>
+struct is_std_array<std::array<T, N>> : std::true_type { };
+
+// the address of the first element of a contiguous range, or null when the
+// range is empty and its first iterator may not be dereferenced
+template <typename I, typename S>
+const iterator_value_t<I>* contiguous_data(const I &first, const S &last) {
+    if (do_sized_distance(first, last) == 0) {
+        return nullptr;
+    }
+
+    return std::addressof(*first);
+}
+
+template <typename O>
+class CopyStep {
+public:
+    template <typename U>
+    constexpr ControlFlow<O> operator()(O out, U &&element) const {
+        *out = std::forward<U>(element);
+        ++out;
+
+        return ControlFlow<O>::proceed(std::move(out));
+    }
+};
+
+template <typename C, typename I, typename S,
+          std::enable_if_t<is_memcpy_extendable<C, I, S>::value, int> = 0>
+void do_extend(C &container, const I &first, const S &last, const SizeHint&,
+               PriorityTag<3>) {
+    const iterator_value_t<I> *const data = contiguous_data(first, last);
+    const auto count =
+        static_cast<std::size_t>(do_sized_distance(first, last));
+
+    container.insert(container.end(), data, data + count);
+}
+
+// how many blocks beyond the lower bound are made room for up front
+constexpr std::size_t NUM_RESERVED_BATCHES = 4;
+
+// blocks are pulled into a buffer on the stack and appended, so the vector
+// is never filled with values that are then overwritten. room is made up
+// front for the lower bound and a few blocks, but never for more than the
+// upper bound, and not at all when the container already has it, so a
+// container that is reused does not allocate again
+template <typename C, typename I, typename S,
+          std::enable_if_t<is_batch_collectable<C, I>::value, int> = 0>
+void do_extend(C &container, I first, const S &last, const SizeHint &hint,
+               PriorityTag<2>) {
+    using ValueT = typename C::value_type;
+
+    std::size_t num_reserved =
+        hint.lower() + NUM_RESERVED_BATCHES * BATCH_SIZE;
+
+    if (hint.upper().has_value()) {
+        num_reserved = std::min(num_reserved, hint.upper().value());
+    }
+
+    if (container.capacity() - container.size() < num_reserved) {
+        container.reserve(container.size() + num_reserved);
+    }
+
+    ValueT block[BATCH_SIZE];
+    std::size_t count;
+
+    while ((count = do_next_batch(first, last, block, BATCH_SIZE)) != 0) {
+        container.insert(container.end(), block, block + count);
+    }
+}
+
+template <typename C, typename I, typename S,
+          std::enable_if_t<is_extend_reservable<C>::value, int> = 0>
+void do_extend(C &container, const I &first, const S &last,
+               const SizeHint &hint, PriorityTag<1>) {
+    container.reserve(container.size() + hint.lower());
+
+    do_extend(container, first, last, hint, PriorityTag<0>{ });
+}
+
+template <typename C, typename I, typename S>
+void do_extend(C &container, const I &first, const S &last, const SizeHint&,
+               PriorityTag<0>) {
+    const InsertStep<C> step{ container };
+    do_try_fold(first, last, Unit{ }, step);
+}
+
+// appends [first, last) to the end of container, reserving for at least the
+// lower bound of hint when the container can
+template <typename C, typename I, typename S>
+void do_extend(C &container, const I &first, const S &last,
+               const SizeHint &hint) {
+    do_extend(container, first, last, hint, PriorityTag<3>{ });
+}
+
+// a container that was just collected into gives back the room that
+// do_extend made for a sparse range, such as a filter, if most of it went
+// unused. containers that belong to the caller are never trimmed
+template <typename I, typename C,
+          std::enable_if_t<is_batch_collectable<C, I>::value, int> = 0>
+void do_trim(C &container, PriorityTag<1>) {
+    if (container.size() < container.capacity() / 2) {
+        container.shrink_to_fit();
+    }
+}
+
+template <typename I, typename C>
+void do_trim(C&, PriorityTag<0>) noexcept { }
+
+template <typename I, typename C>
+void do_trim(C &container) {
+    do_trim<I>(container, PriorityTag<1>{ });
+}
+
+template <typename O, typename I, typename S,
+          std::enable_if_t<
+              is_memcpy_copyable<I, S>::value
+              && std::is_same<O, iterator_value_t<I>*>::value,
+              int
+          > = 0>
+O do_copy(const I &first, const S &last, O out, PriorityTag<1>) {
+    const auto count =
+        static_cast<std::size_t>(do_sized_distance(first, last));
+
+    if (count != 0) {
+        std::memcpy(out, std::addressof(*first), count * sizeof(*out));
+    }
+
+    return out + count;
+}
+
+template <typename O, typename I, typename S>
+O do_copy(const I &first, const S &last, O out, PriorityTag<0>) {
+    const CopyStep<O> step;
+
+    return do_try_fold(first, last, std::move(out), step).value();
+}
+
+template <typename O, typename I, typename S>
+O do_copy(const I &first, const S &last, O out) {
+    return do_copy(first, last, std::move(out), PriorityTag<1>{ });
+}
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
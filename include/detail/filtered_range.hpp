@@ -1,22 +1,59 @@
+#ifndef UMIGV_RANGES_DETAIL_FILTERED_RANGE_HPP
+#define UMIGV_RANGES_DETAIL_FILTERED_RANGE_HPP
+
+#include "callable_storage.hpp"
+
 #include "../apply.hpp"
 #include "../invoke.hpp"
 #include "../traits.hpp"
 
+#include <atomic>
 #include <type_traits>
+
+#include <type_safe/optional.hpp>
 #include <utility>
 
 namespace umigv {
 namespace ranges {
 namespace detail {
 
+// predicates are shown elements as lvalues even when the iterator yields
+// rvalues (as a range from into_iter does), so a predicate that takes its
+// argument by value copies the element rather than moving it out before
+// whatever consumes the filtered range gets to it
+template <typename I>
+using filter_argument_t = std::conditional_t<
+    std::is_rvalue_reference<iterator_reference_t<I>>::value,
+    std::remove_reference_t<iterator_reference_t<I>>&,
+    iterator_reference_t<I>
+>;
+
+template <typename I,
+          std::enable_if_t<
+              !std::is_rvalue_reference<iterator_reference_t<I>>::value, int
+          > = 0>
+constexpr filter_argument_t<I> filter_argument(const I &current) {
+    return *current;
+}
+
+template <typename I,
+          std::enable_if_t<
+              std::is_rvalue_reference<iterator_reference_t<I>>::value, int
+          > = 0>
+constexpr filter_argument_t<I> filter_argument(const I &current) {
+    iterator_reference_t<I> element = *current;
+
+    return element;
+}
+
 template <typename I, typename P, typename = void>
 struct is_invoke_filterable : std::false_type { };
 
 template <typename I, typename P>
 struct is_invoke_filterable<I, P, void_t<std::enable_if_t<
-    ::umigv::ranges::is_invocable<const P&, iterator_reference_t<I>>::value
+    ::umigv::ranges::is_invocable<const P&, filter_argument_t<I>>::value
     && std::is_convertible<
-        ::umigv::ranges::invoke_result_t<const P&, iterator_reference_t<I>>,
+        ::umigv::ranges::invoke_result_t<const P&, filter_argument_t<I>>,
         bool
     >::value
 >>> : std::true_type { };
@@ -26,9 +63,9 @@ struct is_apply_filterable : std::false_type { };
 
 template <typename I, typename P>
 struct is_apply_filterable<I, P, void_t<std::enable_if_t<
-    ::umigv::ranges::is_applicable<const P&, iterator_reference_t<I>>::value
+    ::umigv::ranges::is_applicable<const P&, filter_argument_t<I>>::value
     && std::is_convertible<
-        ::umigv::ranges::apply_result_t<const P&, iterator_reference_t<I>>, bool
+        ::umigv::ranges::apply_result_t<const P&, filter_argument_t<I>>, bool
     >::value
 >>> : std::true_type { };
 
@@ -38,9 +75,9 @@ struct is_filterable
 
 template <typename I, typename P,
           std::enable_if_t<is_invoke_filterable<I, P>::value, int> = 0>
-constexpr void advance(I &current, I &last, const P &predicate) {
+constexpr void advance(I &current, const I &last, const P &predicate) {
     while (!(current == last)
-           && !::umigv::ranges::invoke(predicate, *current)) {
+           && !::umigv::ranges::invoke(predicate, filter_argument(current))) {
         ++current;
     }
 }
@@ -48,12 +85,242 @@ constexpr void advance(I &current, I &last, const P &predicate) {
 template <typename I, typename P,
           std::enable_if_t<!is_invoke_filterable<I, P>::value
                            && is_apply_filterable<I, P>::value, int> = 0>
-constexpr void advance(I &current, I &last, const P &predicate) {
-    while (!(current == last) && !::umigv::ranges::apply(predicate, *current)) {
+constexpr void advance(I &current, const I &last, const P &predicate) {
+    while (!(current == last)
+           && !::umigv::ranges::apply(predicate, filter_argument(current))) {
         ++current;
     }
 }
 
+template <typename T, typename P, typename = void>
+struct is_invoke_testable : std::false_type { };
+
+template <typename T, typename P>
+struct is_invoke_testable<T, P, void_t<std::enable_if_t<
+    ::umigv::ranges::is_invocable<const P&, const T&>::value
+    && std::is_convertible<
+        ::umigv::ranges::invoke_result_t<const P&, const T&>, bool
+    >::value
+>>> : std::true_type { };
+
+template <typename T, typename P, typename = void>
+struct is_apply_testable : std::false_type { };
+
+template <typename T, typename P>
+struct is_apply_testable<T, P, void_t<std::enable_if_t<
+    ::umigv::ranges::is_applicable<const P&, const T&>::value
+    && std::is_convertible<
+        ::umigv::ranges::apply_result_t<const P&, const T&>, bool
+    >::value
+>>> : std::true_type { };
+
+template <typename T, typename P,
+          std::enable_if_t<is_invoke_testable<T, P>::value, int> = 0>
+constexpr bool test(const P &predicate, const T &value) {
+    return ::umigv::ranges::invoke(predicate, value);
+}
+
+template <typename T, typename P,
+          std::enable_if_t<!is_invoke_testable<T, P>::value
+                           && is_apply_testable<T, P>::value, int> = 0>
+constexpr bool test(const P &predicate, const T &value) {
+    return ::umigv::ranges::apply(predicate, value);
+}
+
+template <typename I, typename P, typename T,
+          std::enable_if_t<is_invoke_filterable<I, P>::value, int> = 0>
+constexpr bool filter_value(const P &predicate, T &&value) {
+    return ::umigv::ranges::invoke(predicate, std::forward<T>(value));
+}
+
+template <typename I, typename P, typename T,
+          std::enable_if_t<!is_invoke_filterable<I, P>::value
+                           && is_apply_filterable<I, P>::value, int> = 0>
+constexpr bool filter_value(const P &predicate, T &&value) {
+    return ::umigv::ranges::apply(predicate, std::forward<T>(value));
+}
+
+// an element passes when it passes p and then q, exactly as it would through
+// a range filtered with q over a range filtered with p
+template <typename I, typename P, typename Q>
+class ConjoinedPredicate
+: private CallableSlot<P, ConjoinedPredicate<I, P, Q>, 0>,
+  private CallableSlot<Q, ConjoinedPredicate<I, P, Q>, 1> {
+    using FirstT = CallableSlot<P, ConjoinedPredicate, 0>;
+    using SecondT = CallableSlot<Q, ConjoinedPredicate, 1>;
+
+public:
+    constexpr ConjoinedPredicate(const P &p, const Q &q)
+    noexcept(std::is_nothrow_copy_constructible<P>::value
+             && std::is_nothrow_copy_constructible<Q>::value)
+    : FirstT{ p }, SecondT{ q } { }
+
+    template <typename T>
+    constexpr bool operator()(T &&value) const {
+        return filter_value<I>(static_cast<const FirstT&>(*this).get(), value)
+               && filter_value<I>(static_cast<const SecondT&>(*this).get(),
+                                  value);
+    }
+};
+
+// iterators that produce values (such as a mapped iterator) would otherwise
+// compute each accepted element twice: once for the predicate and once when
+// dereferenced. when the predicate can observe the value through a const
+// reference, the value it was shown is kept and handed back by reference
+// instead. only trivially copyable values are kept: anything else, such as
+// a string, would be copied out of the cache where it used to be moved
+template <typename I, typename P>
+struct is_const_testable
+: disjunction<
+    is_invoke_testable<remove_cvref_t<iterator_reference_t<I>>, P>,
+    is_apply_testable<remove_cvref_t<iterator_reference_t<I>>, P>
+> { };
+
+template <typename I, typename P>
+struct is_dereference_cacheable
+: std::integral_constant<
+    bool,
+    !std::is_reference<iterator_reference_t<I>>::value
+    && std::is_trivially_copyable<
+        std::remove_cv_t<iterator_reference_t<I>>
+    >::value
+    && is_const_testable<I, P>::value
+> { };
+
+template <typename I, typename P,
+          bool = is_dereference_cacheable<I, P>::value>
+class DereferenceCache {
+public:
+    using pointer = iterator_pointer_t<I>;
+    using reference = iterator_reference_t<I>;
+
+    constexpr void advance(I &current, const I &last, const P &predicate) {
+        ::umigv::ranges::detail::advance(current, last, predicate);
+    }
+
+    constexpr void load(const I&, const I&) noexcept { }
+
+    constexpr reference dereference(const I &current) const {
+        return *current;
+    }
+};
+
+template <typename I, typename P>
+class DereferenceCache<I, P, true> {
+    using ValueT = std::remove_cv_t<iterator_reference_t<I>>;
+
+public:
+    using pointer = const ValueT*;
+    using reference = const ValueT&;
+
+    void advance(I &current, const I &last, const P &predicate) {
+        for (; !(current == last); ++current) {
+            value_.emplace(*current);
+
+            if (test(predicate, value_.value())) {
+                return;
+            }
+        }
+
+        value_.reset();
+    }
+
+    void load(const I &current, const I &last) {
+        if (current == last) {
+            value_.reset();
+        } else {
+            value_.emplace(*current);
+        }
+    }
+
+    reference dereference(const I&) const {
+        return value_.value();
+    }
+
+private:
+    type_safe::optional<ValueT> value_;
+};
+
+// where a filtered range starts and, once some call to begin() has found
+// it, where its first match is. the first thread to finish its scan
+// publishes the result; threads that scan at the same time use their own
+// result instead of waiting, so concurrent calls never block. a copy keeps
+// the result only if it had already been published
+template <typename I>
+class FirstMatchCache {
+public:
+    constexpr explicit FirstMatchCache(const I &origin)
+    noexcept(std::is_nothrow_copy_constructible<I>::value)
+    : origin_{ origin }, match_{ origin } { }
+
+    FirstMatchCache(const FirstMatchCache &other)
+    : origin_{ other.origin_ }, match_{ other.copy_match() },
+      state_{ other.match() ? READY : EMPTY } { }
+
+    FirstMatchCache& operator=(const FirstMatchCache &other) {
+        if (this != &other) {
+            state_.store(EMPTY, std::memory_order_relaxed);
+            origin_ = other.origin_;
+            match_ = other.copy_match();
+            state_.store(other.match() ? READY : EMPTY,
+                         std::memory_order_relaxed);
+        }
+
+        return *this;
+    }
+
+    const I& origin() const noexcept {
+        return origin_;
+    }
+
+    // null until a result has been published
+    const I* match() const noexcept {
+        if (state_.load(std::memory_order_acquire) != READY) {
+            return nullptr;
+        }
+
+        return &match_;
+    }
+
+    void reset() noexcept {
+        state_.store(EMPTY, std::memory_order_relaxed);
+    }
+
+    void publish(const I &match) {
+        int expected = EMPTY;
+
+        if (!state_.compare_exchange_strong(expected, WRITING,
+                                            std::memory_order_acquire)) {
+            return;
+        }
+
+        try {
+            match_ = match;
+        } catch (...) {
+            state_.store(EMPTY, std::memory_order_release);
+
+            throw;
+        }
+
+        state_.store(READY, std::memory_order_release);
+    }
+
+private:
+    enum : int { EMPTY, WRITING, READY };
+
+    const I& copy_match() const noexcept {
+        const I *const published = match();
+
+        return published ? *published : origin_;
+    }
+
+    I origin_;
+    I match_;
+    std::atomic<int> state_{ EMPTY };
+};
+
 } // namespace detail
 } // namespace ranges
 } // namesapce umigv
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef UMIGV_RANGES_DETAIL_FOLD_HPP
+#define UMIGV_RANGES_DETAIL_FOLD_HPP
+
+#include "../control_flow.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+template <std::size_t N>
+struct PriorityTag : PriorityTag<N - 1> { };
+
+template <>
+struct PriorityTag<0> { };
+
+template <typename I, typename S, typename T, typename F>
+constexpr ControlFlow<T> do_try_fold(I first, const S &last, T init, F &f,
+                                     PriorityTag<0>) {
+    for (; !(first == last); ++first) {
+        ControlFlow<T> flow = f(std::move(init), *first);
+
+        if (flow.is_stop()) {
+            return flow;
+        }
+
+        init = std::move(flow).value();
+    }
+
+    return ControlFlow<T>::proceed(std::move(init));
+}
+
+template <typename I, typename S, typename T, typename F>
+constexpr auto do_try_fold(const I &first, const S &last, T init, F &f,
+                           PriorityTag<1>)
+-> decltype(try_fold(first, last, std::move(init), f)) {
+    return try_fold(first, last, std::move(init), f);
+}
+
+// adaptor iterators provide a hidden friend try_fold that folds over the
+// iterator they adapt instead, so a whole pipeline runs as one loop over the
+// innermost iterator; any other iterator is stepped one element at a time
+template <typename I, typename S, typename T, typename F>
+constexpr ControlFlow<T> do_try_fold(const I &first, const S &last, T init,
+                                     F &f) {
+    return do_try_fold(first, last, std::move(init), f, PriorityTag<1>{ });
+}
+
+struct Unit { };
+
+template <typename F>
+class FoldStep {
+public:
+    constexpr explicit FoldStep(F &f) noexcept : f_(f) { }
+
+    template <typename T, typename U>
+    constexpr ControlFlow<T> operator()(T acc, U &&element) const {
+        return ControlFlow<T>::proceed(
+            f_(std::move(acc), std::forward<U>(element))
+        );
+    }
+
+private:
+    F &f_;
+};
+
+template <typename F>
+class ForEachStep {
+public:
+    constexpr explicit ForEachStep(F &f) noexcept : f_(f) { }
+
+    template <typename U>
+    constexpr ControlFlow<Unit> operator()(Unit, U &&element) const {
+        f_(std::forward<U>(element));
+
+        return ControlFlow<Unit>::proceed(Unit{ });
+    }
+
+private:
+    F &f_;
+};
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
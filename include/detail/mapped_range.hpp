@@ -1,3 +1,8 @@
+#ifndef UMIGV_RANGES_DETAIL_MAPPED_RANGE_HPP
+#define UMIGV_RANGES_DETAIL_MAPPED_RANGE_HPP
+
+#include "callable_storage.hpp"
+
 #include "../apply.hpp"
 #include "../invoke.hpp"
 #include "../traits.hpp"
@@ -63,6 +68,66 @@ constexpr decltype(auto) do_map(const I &current, const F &f) {
     return ::umigv::ranges::apply(f, *current);
 }
 
+// the return types are spelled out so that asking whether f accepts a value
+// other than the reference of I fails quietly instead of in the body
+template <typename I, typename F, typename T,
+          std::enable_if_t<is_invoke_mappable<I, F>::value, int> = 0>
+constexpr auto map_value(const F &f, T &&value)
+-> decltype(::umigv::ranges::invoke(f, std::forward<T>(value))) {
+    return ::umigv::ranges::invoke(f, std::forward<T>(value));
+}
+
+template <typename I, typename F, typename T,
+          std::enable_if_t<!is_invoke_mappable<I, F>::value
+                           && is_apply_mappable<I, F>::value, int> = 0>
+constexpr auto map_value(const F &f, T &&value)
+-> decltype(::umigv::ranges::apply(f, std::forward<T>(value))) {
+    return ::umigv::ranges::apply(f, std::forward<T>(value));
+}
+
+// a base that is not random access is staged through a buffer of its value
+// type. f is shown the staged copies as const lvalues, so it must accept
+// them by value or by const reference; an f that takes a mutable reference
+// would otherwise modify the copies instead of the elements
+template <typename I, typename F>
+struct is_batch_mappable
+: std::integral_constant<
+    bool,
+    std::is_default_constructible<iterator_value_t<I>>::value
+    && std::is_copy_assignable<iterator_value_t<I>>::value
+    && is_mappable<const iterator_value_t<I>*, F>::value
+> { };
+
+// g applied to the result of f, exactly as a range mapped with g over a
+// range mapped with f would; J is the iterator of the range mapped with f
+template <typename I, typename J, typename F, typename G>
+class ComposedMap
+: private CallableSlot<F, ComposedMap<I, J, F, G>, 0>,
+  private CallableSlot<G, ComposedMap<I, J, F, G>, 1> {
+    using FirstT = CallableSlot<F, ComposedMap, 0>;
+    using SecondT = CallableSlot<G, ComposedMap, 1>;
+
+public:
+    constexpr ComposedMap(const F &f, const G &g)
+    noexcept(std::is_nothrow_copy_constructible<F>::value
+             && std::is_nothrow_copy_constructible<G>::value)
+    : FirstT{ f }, SecondT{ g } { }
+
+    template <typename T>
+    constexpr auto operator()(T &&value) const
+    -> decltype(map_value<J>(std::declval<const G&>(),
+                             map_value<I>(std::declval<const F&>(),
+                                          std::forward<T>(value)))) {
+        return map_value<J>(
+            static_cast<const SecondT&>(*this).get(),
+            map_value<I>(static_cast<const FirstT&>(*this).get(),
+                         std::forward<T>(value))
+        );
+    }
+};
+
 } // namespace detail
 } // namespace ranges
 } // namesapce umigv
+
+#endif
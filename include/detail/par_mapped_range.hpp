@@ -0,0 +1,197 @@
+#ifndef UMIGV_RANGES_DETAIL_PAR_MAPPED_RANGE_HPP
+#define UMIGV_RANGES_DETAIL_PAR_MAPPED_RANGE_HPP
+
+#include "mapped_range.hpp"
+
+#include "../traits.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <type_safe/optional.hpp>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+template <typename I, typename F>
+using par_map_result_t = std::decay_t<decltype(map_value<I>(
+    std::declval<const F&>(), std::declval<iterator_value_t<I>&>()
+))>;
+
+// the consuming thread pulls elements from [first, last) itself and hands
+// them to the workers, never more than window ahead of the element it is
+// waiting for. each result lands in the slot of its sequence number, so
+// results are taken in the order their elements were pulled. an exception
+// thrown by f is rethrown to the consumer in place of its result. the
+// workers are threads of its own rather than a ThreadPool's: the pool only
+// runs jobs whose caller waits for all of them, while this channel streams
+// results as they are pulled and its workers idle whenever the window is
+// full
+template <typename I, typename F>
+class ParMapChannel {
+public:
+    using InputT = iterator_value_t<I>;
+    using ResultT = par_map_result_t<I, F>;
+
+    ParMapChannel(const I &first, const I &last, const F &f,
+                  std::size_t num_threads, std::size_t window)
+    : first_{ first }, last_{ last }, f_{ f }, slots_(window) {
+        workers_.reserve(num_threads);
+
+        try {
+            for (std::size_t i = 0; i < num_threads; ++i) {
+                workers_.emplace_back([this] { work(); });
+            }
+        } catch (...) {
+            stop();
+
+            throw;
+        }
+    }
+
+    ParMapChannel(const ParMapChannel &other) = delete;
+
+    ParMapChannel& operator=(const ParMapChannel &other) = delete;
+
+    ~ParMapChannel() {
+        stop();
+    }
+
+    // waits for the next result and returns false once there is none
+    bool next() {
+        issue();
+
+        if (num_taken_ == num_issued_) {
+            result_.reset();
+
+            return false;
+        }
+
+        Slot &slot = slots_[num_taken_ % slots_.size()];
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        ready_condition_.wait(lock, [&slot] { return slot.is_ready; });
+
+        slot.is_ready = false;
+        ++num_taken_;
+
+        if (slot.exception) {
+            result_.reset();
+            std::rethrow_exception(std::exchange(slot.exception, nullptr));
+        }
+
+        result_.emplace(std::move(slot.result.value()));
+        slot.result.reset();
+
+        return true;
+    }
+
+    const ResultT& current() const {
+        return result_.value();
+    }
+
+private:
+    struct Task {
+        std::size_t index;
+        InputT input;
+    };
+
+    struct Slot {
+        type_safe::optional<ResultT> result;
+        std::exception_ptr exception;
+        bool is_ready = false;
+    };
+
+    void stop() noexcept {
+        {
+            std::lock_guard<std::mutex> lock{ mutex_ };
+            is_stopping_ = true;
+        }
+
+        task_condition_.notify_all();
+
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void issue() {
+        while (!(first_ == last_)
+               && num_issued_ - num_taken_ < slots_.size()) {
+            InputT input(*first_);
+            ++first_;
+
+            {
+                std::lock_guard<std::mutex> lock{ mutex_ };
+                tasks_.push_back(Task{ num_issued_, std::move(input) });
+            }
+
+            ++num_issued_;
+            task_condition_.notify_one();
+        }
+    }
+
+    void work() {
+        while (true) {
+            std::unique_lock<std::mutex> lock{ mutex_ };
+            task_condition_.wait(lock, [this] {
+                return is_stopping_ || !tasks_.empty();
+            });
+
+            if (is_stopping_) {
+                return;
+            }
+
+            Task task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+
+            Slot &slot = slots_[task.index % slots_.size()];
+
+            try {
+                ResultT result = map_value<I>(f_, task.input);
+
+                lock.lock();
+                slot.result.emplace(std::move(result));
+            } catch (...) {
+                if (!lock.owns_lock()) {
+                    lock.lock();
+                }
+
+                slot.exception = std::current_exception();
+            }
+
+            slot.is_ready = true;
+            lock.unlock();
+
+            ready_condition_.notify_one();
+        }
+    }
+
+    I first_;
+    I last_;
+    const F f_;
+    std::vector<Slot> slots_;
+    std::size_t num_issued_ = 0;
+    std::size_t num_taken_ = 0;
+    type_safe::optional<ResultT> result_;
+    std::deque<Task> tasks_;
+    std::mutex mutex_;
+    std::condition_variable task_condition_;
+    std::condition_variable ready_condition_;
+    bool is_stopping_ = false;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
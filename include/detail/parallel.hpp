@@ -0,0 +1,123 @@
+#ifndef UMIGV_RANGES_DETAIL_PARALLEL_HPP
+#define UMIGV_RANGES_DETAIL_PARALLEL_HPP
+
+#include "fold.hpp"
+
+#include "../control_flow.hpp"
+#include "../thread_pool.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+template <typename O>
+class AssignStep {
+public:
+    constexpr explicit AssignStep(O &output) noexcept : output_(output) { }
+
+    template <typename U>
+    constexpr ControlFlow<Unit> operator()(Unit, U &&element) const {
+        *output_ = std::forward<U>(element);
+        ++output_;
+
+        return ControlFlow<Unit>::proceed(Unit{ });
+    }
+
+private:
+    O &output_;
+};
+
+// keeps std::vector<bool> from packing partial results into shared words
+template <typename T>
+struct ReduceSlot {
+    T value;
+};
+
+template <typename I, typename F>
+void par_for_each(const I &first, std::size_t count, F &f,
+                  const Parallelism &parallelism) {
+    using DifferenceT = iterator_difference_t<I>;
+
+    const ForEachStep<F> step{ f };
+
+    parallelism.pool().parallel_for(
+        count, parallelism.grain(count),
+        [&first, &step](std::size_t lower, std::size_t upper) {
+            do_try_fold(first + static_cast<DifferenceT>(lower),
+                        first + static_cast<DifferenceT>(upper), Unit{ },
+                        step);
+        }
+    );
+}
+
+template <typename I, typename T, typename F>
+T par_reduce(const I &first, std::size_t count, T identity, F &f,
+             const Parallelism &parallelism) {
+    using DifferenceT = iterator_difference_t<I>;
+
+    const std::size_t grain = parallelism.grain(count);
+    const std::size_t num_chunks = (count + grain - 1) / grain;
+    std::vector<ReduceSlot<T>> partials(num_chunks, ReduceSlot<T>{ identity });
+    const FoldStep<F> step{ f };
+
+    parallelism.pool().parallel_for(
+        num_chunks, 1,
+        [&](std::size_t lower, std::size_t upper) {
+            for (std::size_t chunk = lower; chunk < upper; ++chunk) {
+                const std::size_t chunk_first = chunk * grain;
+                const std::size_t chunk_last =
+                    std::min(chunk_first + grain, count);
+
+                partials[chunk].value = do_try_fold(
+                    first + static_cast<DifferenceT>(chunk_first),
+                    first + static_cast<DifferenceT>(chunk_last),
+                    identity, step
+                ).value();
+            }
+        }
+    );
+
+    T reduced = std::move(identity);
+
+    for (auto &partial : partials) {
+        reduced = f(std::move(reduced), std::move(partial.value));
+    }
+
+    return reduced;
+}
+
+template <typename T, typename I>
+std::vector<T> par_collect(const I &first, std::size_t count,
+                           const Parallelism &parallelism) {
+    using DifferenceT = iterator_difference_t<I>;
+    using OutputT = typename std::vector<T>::iterator;
+
+    std::vector<T> collected(count);
+
+    parallelism.pool().parallel_for(
+        count, parallelism.grain(count),
+        [&first, &collected](std::size_t lower, std::size_t upper) {
+            OutputT output =
+                collected.begin() + static_cast<DifferenceT>(lower);
+            const AssignStep<OutputT> step{ output };
+
+            do_try_fold(first + static_cast<DifferenceT>(lower),
+                        first + static_cast<DifferenceT>(upper), Unit{ },
+                        step);
+        }
+    );
+
+    return collected;
+}
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef UMIGV_RANGES_DETAIL_POSTFIX_PROXY_HPP
+#define UMIGV_RANGES_DETAIL_POSTFIX_PROXY_HPP
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+// what it++ returns from an input iterator whose copies all share one
+// position. the element is copied out before the position moves on, so
+// *it++ still refers to the element that it pointed to
+template <typename T>
+class PostfixProxy {
+public:
+    explicit PostfixProxy(const T &value)
+    noexcept(std::is_nothrow_copy_constructible<T>::value)
+    : value_(value) { }
+
+    const T& operator*() const noexcept {
+        return value_;
+    }
+
+    const T* operator->() const noexcept {
+        return std::addressof(value_);
+    }
+
+private:
+    T value_;
+};
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef UMIGV_RANGES_DETAIL_PREFETCHED_RANGE_HPP
+#define UMIGV_RANGES_DETAIL_PREFETCHED_RANGE_HPP
+
+#include "fold.hpp"
+
+#include "../control_flow.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/optional.hpp>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+// a fixed capacity queue for exactly one producer and one consumer thread.
+// each index is written by only one side, so no locks are needed; the
+// padding keeps the two indices on separate cache lines
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(std::size_t capacity)
+    : slots_{ std::make_unique<SlotT[]>(capacity) }, capacity_{ capacity } { }
+
+    SpscRing(const SpscRing &other) = delete;
+
+    SpscRing& operator=(const SpscRing &other) = delete;
+
+    ~SpscRing() {
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+
+        for (auto head = head_.load(std::memory_order_relaxed); head != tail;
+             ++head) {
+            slot(head)->~T();
+        }
+    }
+
+    // producer only; value is left untouched if the ring is full
+    bool try_push(T &&value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+
+        if (tail - head_.load(std::memory_order_acquire) == capacity_) {
+            return false;
+        }
+
+        ::new (static_cast<void*>(slot(tail))) T(std::move(value));
+        tail_.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    // producer only
+    bool is_full() const noexcept {
+        return tail_.load(std::memory_order_relaxed)
+               - head_.load(std::memory_order_acquire) == capacity_;
+    }
+
+    // consumer only
+    bool is_empty() const noexcept {
+        return head_.load(std::memory_order_relaxed)
+               == tail_.load(std::memory_order_acquire);
+    }
+
+    // consumer only
+    bool try_pop(type_safe::optional<T> &value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        T *const element = slot(head);
+        value.emplace(std::move(*element));
+        element->~T();
+        head_.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+private:
+    using SlotT = std::aligned_storage_t<sizeof(T), alignof(T)>;
+    using IndexT = std::atomic<std::size_t>;
+
+    T* slot(std::size_t index) noexcept {
+        return reinterpret_cast<T*>(&slots_[index % capacity_]);
+    }
+
+    std::unique_ptr<SlotT[]> slots_;
+    std::size_t capacity_;
+    IndexT head_{ 0 };
+    char head_padding_[CACHE_LINE_SIZE - sizeof(IndexT)];
+    IndexT tail_{ 0 };
+    char tail_padding_[CACHE_LINE_SIZE - sizeof(IndexT)];
+};
+
+// runs [first, last) on its own thread, pushing every element into a ring
+// that the consuming thread drains. an exception thrown upstream ends the
+// sequence and is rethrown to the consumer once it has taken every element
+// produced before it. destroying the channel stops the producer early.
+// either side yields for a few tries when the ring is empty or full, then
+// sleeps until the other side wakes it
+template <typename T>
+class PrefetchChannel {
+public:
+    template <typename I>
+    PrefetchChannel(const I &first, const I &last, std::size_t capacity)
+    : ring_{ capacity } {
+        producer_ = std::thread{ [this, first, last] {
+            produce(first, last);
+        } };
+    }
+
+    PrefetchChannel(const PrefetchChannel &other) = delete;
+
+    PrefetchChannel& operator=(const PrefetchChannel &other) = delete;
+
+    ~PrefetchChannel() {
+        is_cancelled_.store(true, std::memory_order_relaxed);
+        wake(is_producer_waiting_, producer_condition_);
+        producer_.join();
+    }
+
+    // waits for the next element and returns false once there is none
+    bool next() {
+        for (std::size_t num_tries = 0; !ring_.try_pop(current_); ++num_tries) {
+            if (is_done_.load(std::memory_order_acquire)) {
+                if (ring_.try_pop(current_)) {
+                    break;
+                }
+
+                current_.reset();
+                rethrow_if_failed();
+
+                return false;
+            }
+
+            pause(num_tries, is_consumer_waiting_, consumer_condition_,
+                  [this] {
+                      return !ring_.is_empty()
+                             || is_done_.load(std::memory_order_relaxed);
+                  });
+        }
+
+        wake(is_producer_waiting_, producer_condition_);
+
+        return true;
+    }
+
+    const T& current() const {
+        return current_.value();
+    }
+
+private:
+    static constexpr std::size_t NUM_SPINS = 64;
+
+    class PushStep {
+    public:
+        explicit PushStep(PrefetchChannel &channel) noexcept
+        : channel_(channel) { }
+
+        template <typename U>
+        ControlFlow<Unit> operator()(Unit, U &&element) const {
+            if (!channel_.push(T(std::forward<U>(element)))) {
+                return ControlFlow<Unit>::stop(Unit{ });
+            }
+
+            return ControlFlow<Unit>::proceed(Unit{ });
+        }
+
+    private:
+        PrefetchChannel &channel_;
+    };
+
+    template <typename I>
+    void produce(const I &first, const I &last) noexcept {
+        try {
+            PushStep step{ *this };
+
+            do_try_fold(first, last, Unit{ }, step);
+        } catch (...) {
+            exception_ = std::current_exception();
+        }
+
+        is_done_.store(true, std::memory_order_release);
+        wake(is_consumer_waiting_, consumer_condition_);
+    }
+
+    bool push(T &&element) {
+        for (std::size_t num_tries = 0;
+             !is_cancelled_.load(std::memory_order_relaxed); ++num_tries) {
+            if (ring_.try_push(std::move(element))) {
+                wake(is_consumer_waiting_, consumer_condition_);
+
+                return true;
+            }
+
+            pause(num_tries, is_producer_waiting_, producer_condition_,
+                  [this] {
+                      return !ring_.is_full()
+                             || is_cancelled_.load(std::memory_order_relaxed);
+                  });
+        }
+
+        return false;
+    }
+
+    // the fences pair up with the ones in wake: either the waiting side sees
+    // the change it is waiting for, or the other side sees its flag and
+    // notifies it under the lock
+    template <typename P>
+    void pause(std::size_t num_tries, std::atomic<bool> &is_waiting,
+               std::condition_variable &condition, P is_ready) {
+        if (num_tries < NUM_SPINS) {
+            std::this_thread::yield();
+
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        is_waiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        condition.wait(lock, is_ready);
+        is_waiting.store(false, std::memory_order_relaxed);
+    }
+
+    void wake(const std::atomic<bool> &is_waiting,
+              std::condition_variable &condition) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (is_waiting.load(std::memory_order_relaxed)) {
+            const std::lock_guard<std::mutex> lock{ mutex_ };
+            condition.notify_one();
+        }
+    }
+
+    void rethrow_if_failed() {
+        if (exception_) {
+            std::rethrow_exception(std::exchange(exception_, nullptr));
+        }
+    }
+
+    SpscRing<T> ring_;
+    type_safe::optional<T> current_;
+    std::exception_ptr exception_;
+    std::atomic<bool> is_done_{ false };
+    std::atomic<bool> is_cancelled_{ false };
+    std::atomic<bool> is_consumer_waiting_{ false };
+    std::atomic<bool> is_producer_waiting_{ false };
+    std::mutex mutex_;
+    std::condition_variable consumer_condition_;
+    std::condition_variable producer_condition_;
+    std::thread producer_;
+};
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -0,0 +1,320 @@
+#ifndef UMIGV_RANGES_DETAIL_REDUCE_HPP
+#define UMIGV_RANGES_DETAIL_REDUCE_HPP
+
+#include "batch.hpp"
+#include "fold.hpp"
+#include "size_hint.hpp"
+
+#include "../control_flow.hpp"
+#include "../traits.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/optional.hpp>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+// element i of a reduction always lands in lane i % REDUCE_LANES and the
+// lanes are combined in a fixed order, so a result depends only on the
+// elements and not on how they were split into blocks or on the target.
+// the lanes are independent, which lets the compiler keep them in vector
+// registers
+constexpr std::size_t REDUCE_LANES = 8;
+
+template <typename T>
+class SumKernel {
+public:
+    void operator()(const T *values, std::size_t count) noexcept {
+        std::size_t i = 0;
+
+        for (; i < count && lane_ != 0; ++i) {
+            push(values[i]);
+        }
+
+        for (; i + REDUCE_LANES <= count; i += REDUCE_LANES) {
+            for (std::size_t j = 0; j < REDUCE_LANES; ++j) {
+                lanes_[j] += values[i + j];
+            }
+        }
+
+        for (; i < count; ++i) {
+            push(values[i]);
+        }
+    }
+
+    T result() const noexcept {
+        return static_cast<T>(((lanes_[0] + lanes_[1])
+                               + (lanes_[2] + lanes_[3]))
+                              + ((lanes_[4] + lanes_[5])
+                                 + (lanes_[6] + lanes_[7])));
+    }
+
+private:
+    void push(const T &value) noexcept {
+        lanes_[lane_] += value;
+        lane_ = (lane_ + 1) % REDUCE_LANES;
+    }
+
+    T lanes_[REDUCE_LANES] = { };
+    std::size_t lane_ = 0;
+};
+
+struct Less {
+    template <typename T>
+    constexpr bool operator()(const T &lhs, const T &rhs) const {
+        return lhs < rhs;
+    }
+};
+
+struct Greater {
+    template <typename T>
+    constexpr bool operator()(const T &lhs, const T &rhs) const {
+        return rhs < lhs;
+    }
+};
+
+// keeps the element that compares first under Compare in each lane; the
+// lanes start out as copies of the first element seen
+template <typename T, typename Compare>
+class ExtremumKernel {
+public:
+    void operator()(const T *values, std::size_t count) noexcept {
+        if (count == 0) {
+            return;
+        }
+
+        if (!is_seeded_) {
+            for (auto &lane : lanes_) {
+                lane = values[0];
+            }
+
+            is_seeded_ = true;
+        }
+
+        std::size_t i = 0;
+
+        for (; i + REDUCE_LANES <= count; i += REDUCE_LANES) {
+            for (std::size_t j = 0; j < REDUCE_LANES; ++j) {
+                lanes_[j] = Compare{ }(values[i + j], lanes_[j])
+                            ? values[i + j] : lanes_[j];
+            }
+        }
+
+        for (; i < count; ++i) {
+            lanes_[0] = Compare{ }(values[i], lanes_[0]) ? values[i]
+                                                         : lanes_[0];
+        }
+    }
+
+    type_safe::optional<T> result() const {
+        if (!is_seeded_) {
+            return type_safe::nullopt;
+        }
+
+        T extremum = lanes_[0];
+
+        for (std::size_t j = 1; j < REDUCE_LANES; ++j) {
+            extremum = Compare{ }(lanes_[j], extremum) ? lanes_[j] : extremum;
+        }
+
+        return extremum;
+    }
+
+private:
+    T lanes_[REDUCE_LANES] = { };
+    bool is_seeded_ = false;
+};
+
+template <typename T>
+class MinMaxKernel {
+public:
+    void operator()(const T *values, std::size_t count) noexcept {
+        min_(values, count);
+        max_(values, count);
+    }
+
+    type_safe::optional<std::pair<T, T>> result() const {
+        const type_safe::optional<T> min = min_.result();
+
+        if (!min.has_value()) {
+            return type_safe::nullopt;
+        }
+
+        return std::make_pair(min.value(), max_.result().value());
+    }
+
+private:
+    ExtremumKernel<T, Less> min_;
+    ExtremumKernel<T, Greater> max_;
+};
+
+class CountKernel {
+public:
+    template <typename T>
+    void operator()(const T*, std::size_t count) noexcept {
+        count_ += count;
+    }
+
+    std::size_t result() const noexcept {
+        return count_;
+    }
+
+private:
+    std::size_t count_ = 0;
+};
+
+// contiguous arithmetic ranges are handed to the kernel in place; anything
+// else is pulled through a block buffer with next_batch
+template <typename I, typename S, typename K,
+          std::enable_if_t<is_contiguous_iterator<I>::value
+                           && is_sized<I, S>::value, int> = 0>
+void reduce_blocks(const I &first, const S &last, K &kernel) {
+    const auto count =
+        static_cast<std::size_t>(do_sized_distance(first, last));
+
+    if (count != 0) {
+        kernel(std::addressof(*first), count);
+    }
+}
+
+template <typename I, typename S, typename K,
+          std::enable_if_t<!(is_contiguous_iterator<I>::value
+                             && is_sized<I, S>::value), int> = 0>
+void reduce_blocks(I first, const S &last, K &kernel) {
+    iterator_value_t<I> block[BATCH_SIZE];
+    std::size_t count;
+
+    while ((count = do_next_batch(first, last, block, BATCH_SIZE)) != 0) {
+        kernel(static_cast<const iterator_value_t<I>*>(block), count);
+    }
+}
+
+template <typename I>
+struct is_lane_reducible
+: std::integral_constant<
+    bool,
+    std::is_arithmetic<iterator_value_t<I>>::value
+    && !std::is_same<iterator_value_t<I>, bool>::value
+> { };
+
+template <typename I, typename S,
+          std::enable_if_t<is_lane_reducible<I>::value, int> = 0>
+iterator_value_t<I> do_sum(const I &first, const S &last) {
+    SumKernel<iterator_value_t<I>> kernel;
+    reduce_blocks(first, last, kernel);
+
+    return kernel.result();
+}
+
+template <typename I, typename S,
+          std::enable_if_t<!is_lane_reducible<I>::value, int> = 0>
+iterator_value_t<I> do_sum(const I &first, const S &last) {
+    using T = iterator_value_t<I>;
+
+    auto plus = [](T acc, auto &&element) {
+        return std::move(acc) + std::forward<decltype(element)>(element);
+    };
+    FoldStep<decltype(plus)> step{ plus };
+
+    return do_try_fold(first, last, T{ }, step).value();
+}
+
+template <typename Compare, typename I, typename S,
+          std::enable_if_t<is_lane_reducible<I>::value, int> = 0>
+type_safe::optional<iterator_value_t<I>> do_extremum(const I &first,
+                                                     const S &last) {
+    ExtremumKernel<iterator_value_t<I>, Compare> kernel;
+    reduce_blocks(first, last, kernel);
+
+    return kernel.result();
+}
+
+template <typename Compare, typename I, typename S,
+          std::enable_if_t<!is_lane_reducible<I>::value, int> = 0>
+type_safe::optional<iterator_value_t<I>> do_extremum(const I &first,
+                                                     const S &last) {
+    using OptionalT = type_safe::optional<iterator_value_t<I>>;
+
+    auto keep = [](OptionalT acc, auto &&element) {
+        if (!acc.has_value() || Compare{ }(element, acc.value())) {
+            acc.emplace(std::forward<decltype(element)>(element));
+        }
+
+        return acc;
+    };
+    FoldStep<decltype(keep)> step{ keep };
+
+    return do_try_fold(first, last, OptionalT{ }, step).value();
+}
+
+template <typename I, typename S,
+          std::enable_if_t<is_lane_reducible<I>::value, int> = 0>
+type_safe::optional<std::pair<iterator_value_t<I>, iterator_value_t<I>>>
+do_minmax(const I &first, const S &last) {
+    MinMaxKernel<iterator_value_t<I>> kernel;
+    reduce_blocks(first, last, kernel);
+
+    return kernel.result();
+}
+
+template <typename I, typename S,
+          std::enable_if_t<!is_lane_reducible<I>::value, int> = 0>
+type_safe::optional<std::pair<iterator_value_t<I>, iterator_value_t<I>>>
+do_minmax(const I &first, const S &last) {
+    using T = iterator_value_t<I>;
+    using OptionalT = type_safe::optional<std::pair<T, T>>;
+
+    auto keep = [](OptionalT acc, auto &&element) {
+        if (!acc.has_value()) {
+            acc.emplace(element, element);
+        } else if (element < acc.value().first) {
+            acc.value().first = element;
+        } else if (acc.value().second < element) {
+            acc.value().second = element;
+        }
+
+        return acc;
+    };
+    FoldStep<decltype(keep)> step{ keep };
+
+    return do_try_fold(first, last, OptionalT{ }, step).value();
+}
+
+template <typename I, typename S,
+          std::enable_if_t<is_sized<I, S>::value, int> = 0>
+std::size_t do_count(const I &first, const S &last, PriorityTag<2>) {
+    return static_cast<std::size_t>(do_sized_distance(first, last));
+}
+
+template <typename I, typename S,
+          std::enable_if_t<is_lane_reducible<I>::value, int> = 0>
+std::size_t do_count(const I &first, const S &last, PriorityTag<1>) {
+    CountKernel kernel;
+    reduce_blocks(first, last, kernel);
+
+    return kernel.result();
+}
+
+template <typename I, typename S>
+std::size_t do_count(const I &first, const S &last, PriorityTag<0>) {
+    auto increment = [](std::size_t acc, auto&&) { return acc + 1; };
+    FoldStep<decltype(increment)> step{ increment };
+
+    return do_try_fold(first, last, std::size_t{ 0 }, step).value();
+}
+
+template <typename I, typename S>
+std::size_t do_count(const I &first, const S &last) {
+    return do_count(first, last, PriorityTag<2>{ });
+}
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
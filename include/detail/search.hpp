@@ -0,0 +1,263 @@
+#ifndef UMIGV_RANGES_DETAIL_SEARCH_HPP
+#define UMIGV_RANGES_DETAIL_SEARCH_HPP
+
+#include "fold.hpp"
+#include "size_hint.hpp"
+
+#include "../control_flow.hpp"
+#include "../invoke.hpp"
+#include "../traits.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <type_safe/optional.hpp>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+template <typename P, typename R, typename = void>
+struct is_search_predicate : std::false_type { };
+
+template <typename P, typename R>
+struct is_search_predicate<P, R, void_t<std::enable_if_t<
+    ::umigv::ranges::is_invocable<const P&, R>::value
+    && std::is_convertible<
+        ::umigv::ranges::invoke_result_t<const P&, R>, bool
+    >::value
+>>> : std::true_type { };
+
+template <typename T>
+class EqualTo {
+public:
+    constexpr explicit EqualTo(const T &value) noexcept : value_(value) { }
+
+    template <typename U>
+    constexpr bool operator()(const U &element) const {
+        return element == value_;
+    }
+
+private:
+    const T &value_;
+};
+
+template <typename T>
+struct is_byte_like
+: true_type_if_t<std::is_same<T, char>::value
+                 || std::is_same<T, signed char>::value
+                 || std::is_same<T, unsigned char>::value> { };
+
+// a contiguous range of arithmetic elements can be searched for a value of
+// the same type without going through the iterators one at a time
+template <typename I, typename S, typename T>
+struct is_scan_searchable
+: true_type_if_t<is_contiguous_iterator<I>::value && is_sized<I, S>::value
+                 && std::is_arithmetic<iterator_value_t<I>>::value
+                 && std::is_same<iterator_value_t<I>, T>::value> { };
+
+constexpr std::size_t SCAN_BLOCK_SIZE = 16;
+
+template <typename T, std::enable_if_t<is_byte_like<T>::value, int> = 0>
+const T* scan(const T *first, std::size_t count, const T &value) noexcept {
+    const void *const found =
+        std::memchr(first, static_cast<unsigned char>(value), count);
+
+    return found ? static_cast<const T*>(found) : first + count;
+}
+
+// every comparison in a block is made before branching, which vectorizes;
+// only the block with the match is searched one element at a time
+template <typename T, std::enable_if_t<!is_byte_like<T>::value, int> = 0>
+const T* scan(const T *first, std::size_t count, const T &value) noexcept {
+    const T *const last = first + count;
+
+    for (; static_cast<std::size_t>(last - first) >= SCAN_BLOCK_SIZE;
+         first += SCAN_BLOCK_SIZE) {
+        bool is_found = false;
+
+        for (std::size_t i = 0; i < SCAN_BLOCK_SIZE; ++i) {
+            is_found |= (first[i] == value);
+        }
+
+        if (is_found) {
+            break;
+        }
+    }
+
+    for (; first != last; ++first) {
+        if (*first == value) {
+            return first;
+        }
+    }
+
+    return last;
+}
+
+template <typename I, typename S, typename T>
+std::size_t scan_index(const I &first, const S &last, const T &value) {
+    const auto count =
+        static_cast<std::size_t>(do_sized_distance(first, last));
+
+    if (count == 0) {
+        return 0;
+    }
+
+    const T *const data = std::addressof(*first);
+
+    return static_cast<std::size_t>(scan(data, count, value) - data);
+}
+
+template <typename P>
+class FindStep {
+public:
+    constexpr explicit FindStep(const P &predicate) noexcept
+    : predicate_(predicate) { }
+
+    template <typename T, typename U>
+    constexpr ControlFlow<type_safe::optional<T>>
+    operator()(type_safe::optional<T> acc, U &&element) const {
+        if (::umigv::ranges::invoke(predicate_, element)) {
+            acc.emplace(std::forward<U>(element));
+
+            return ControlFlow<type_safe::optional<T>>::stop(std::move(acc));
+        }
+
+        return ControlFlow<type_safe::optional<T>>::proceed(std::move(acc));
+    }
+
+private:
+    const P &predicate_;
+};
+
+template <typename P>
+class PositionStep {
+public:
+    constexpr explicit PositionStep(const P &predicate) noexcept
+    : predicate_(predicate) { }
+
+    template <typename U>
+    constexpr ControlFlow<std::size_t> operator()(std::size_t index,
+                                                  U &&element) const {
+        if (::umigv::ranges::invoke(predicate_, std::forward<U>(element))) {
+            return ControlFlow<std::size_t>::stop(index);
+        }
+
+        return ControlFlow<std::size_t>::proceed(index + 1);
+    }
+
+private:
+    const P &predicate_;
+};
+
+// stops at the first element for which the predicate returns Expected
+template <typename P, bool Expected>
+class AnyStep {
+public:
+    constexpr explicit AnyStep(const P &predicate) noexcept
+    : predicate_(predicate) { }
+
+    template <typename U>
+    constexpr ControlFlow<Unit> operator()(Unit, U &&element) const {
+        if (static_cast<bool>(::umigv::ranges::invoke(
+                predicate_, std::forward<U>(element)
+            )) == Expected) {
+            return ControlFlow<Unit>::stop(Unit{ });
+        }
+
+        return ControlFlow<Unit>::proceed(Unit{ });
+    }
+
+private:
+    const P &predicate_;
+};
+
+template <typename I, typename S, typename P>
+type_safe::optional<iterator_value_t<I>>
+do_find_if(const I &first, const S &last, const P &predicate) {
+    const FindStep<P> step{ predicate };
+
+    return do_try_fold(first, last,
+                       type_safe::optional<iterator_value_t<I>>{ },
+                       step).value();
+}
+
+template <typename I, typename S, typename T,
+          std::enable_if_t<is_scan_searchable<I, S, T>::value, int> = 0>
+type_safe::optional<iterator_value_t<I>>
+do_find(const I &first, const S &last, const T &value) {
+    const auto count =
+        static_cast<std::size_t>(do_sized_distance(first, last));
+    const std::size_t index = scan_index(first, last, value);
+
+    if (index == count) {
+        return type_safe::nullopt;
+    }
+
+    // the element can differ from an equal value, e.g. -0.0 and 0.0
+    return std::addressof(*first)[index];
+}
+
+template <typename I, typename S, typename T,
+          std::enable_if_t<!is_scan_searchable<I, S, T>::value, int> = 0>
+type_safe::optional<iterator_value_t<I>>
+do_find(const I &first, const S &last, const T &value) {
+    return do_find_if(first, last, EqualTo<T>{ value });
+}
+
+template <typename I, typename S, typename P>
+type_safe::optional<std::size_t>
+do_position_if(const I &first, const S &last, const P &predicate) {
+    const PositionStep<P> step{ predicate };
+    const ControlFlow<std::size_t> flow =
+        do_try_fold(first, last, std::size_t{ 0 }, step);
+
+    if (!flow.is_stop()) {
+        return type_safe::nullopt;
+    }
+
+    return flow.value();
+}
+
+template <typename I, typename S, typename T,
+          std::enable_if_t<is_scan_searchable<I, S, T>::value, int> = 0>
+type_safe::optional<std::size_t> do_position(const I &first, const S &last,
+                                             const T &value) {
+    const std::size_t index = scan_index(first, last, value);
+
+    if (index == static_cast<std::size_t>(do_sized_distance(first, last))) {
+        return type_safe::nullopt;
+    }
+
+    return index;
+}
+
+template <typename I, typename S, typename T,
+          std::enable_if_t<!is_scan_searchable<I, S, T>::value, int> = 0>
+type_safe::optional<std::size_t> do_position(const I &first, const S &last,
+                                             const T &value) {
+    return do_position_if(first, last, EqualTo<T>{ value });
+}
+
+template <typename I, typename S, typename P>
+bool do_any(const I &first, const S &last, const P &predicate) {
+    const AnyStep<P, true> step{ predicate };
+
+    return do_try_fold(first, last, Unit{ }, step).is_stop();
+}
+
+template <typename I, typename S, typename P>
+bool do_all(const I &first, const S &last, const P &predicate) {
+    const AnyStep<P, false> step{ predicate };
+
+    return !do_try_fold(first, last, Unit{ }, step).is_stop();
+}
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef UMIGV_RANGES_DETAIL_SENTINEL_HPP
+#define UMIGV_RANGES_DETAIL_SENTINEL_HPP
+
+#include "../sentinel.hpp"
+#include "../traits.hpp"
+
+#include <type_traits>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+// adaptor iterators over I end either at a Sentinel<I> or at another
+// adaptor iterator of their own type
+template <typename S, typename I, typename Self>
+struct is_end_of
+: disjunction<std::is_same<S, Sentinel<I>>, std::is_same<S, Self>> { };
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
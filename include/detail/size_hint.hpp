@@ -0,0 +1,97 @@
+#ifndef UMIGV_RANGES_DETAIL_SIZE_HINT_HPP
+#define UMIGV_RANGES_DETAIL_SIZE_HINT_HPP
+
+#include "fold.hpp"
+
+#include "../size_hint.hpp"
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+template <typename I, typename S>
+constexpr auto do_sized_distance(const I &first, const S &last,
+                                 PriorityTag<1>)
+-> decltype(sized_distance(first, last)) {
+    return sized_distance(first, last);
+}
+
+template <typename I,
+          std::enable_if_t<is_random_access_iterator<I>::value, int> = 0>
+constexpr iterator_difference_t<I> do_sized_distance(const I &first,
+                                                     const I &last,
+                                                     PriorityTag<0>) {
+    return last - first;
+}
+
+// adaptors that neither add nor remove elements provide a hidden friend
+// sized_distance when the iterator they adapt knows its distance
+template <typename I, typename S>
+constexpr auto do_sized_distance(const I &first, const S &last)
+-> decltype(do_sized_distance(first, last, PriorityTag<1>{ })) {
+    return do_sized_distance(first, last, PriorityTag<1>{ });
+}
+
+template <typename I, typename S, typename = void>
+struct is_sized : std::false_type { };
+
+template <typename I, typename S>
+struct is_sized<I, S, void_t<decltype(do_sized_distance(
+    std::declval<const I&>(), std::declval<const S&>()
+))>> : std::true_type { };
+
+template <typename I, typename S,
+          std::enable_if_t<is_sized<I, S>::value, int> = 0>
+constexpr SizeHint do_size_hint(const I &first, const S &last,
+                                PriorityTag<2>) {
+    return SizeHint::exact(
+        static_cast<std::size_t>(do_sized_distance(first, last))
+    );
+}
+
+template <typename I, typename S>
+constexpr auto do_size_hint(const I &first, const S &last, PriorityTag<1>)
+-> decltype(size_hint(first, last)) {
+    return size_hint(first, last);
+}
+
+template <typename I, typename S>
+constexpr SizeHint do_size_hint(const I&, const S&, PriorityTag<0>) noexcept {
+    return SizeHint::unknown();
+}
+
+template <typename I, typename S>
+constexpr SizeHint do_size_hint(const I &first, const S &last) {
+    return do_size_hint(first, last, PriorityTag<2>{ });
+}
+
+inline SizeHint min_size_hint(const SizeHint &hint) noexcept {
+    return hint;
+}
+
+template <typename ...Hs>
+constexpr SizeHint min_size_hint(const SizeHint &first,
+                                 const SizeHint &second, const Hs &...rest) {
+    const auto &upper = first.upper().has_value()
+                        ? (second.upper().has_value()
+                           && second.upper().value() < first.upper().value()
+                           ? second.upper() : first.upper())
+                        : second.upper();
+
+    return min_size_hint(
+        SizeHint{ std::min(first.lower(), second.lower()), upper },
+        rest...
+    );
+}
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
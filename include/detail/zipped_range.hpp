@@ -0,0 +1,174 @@
+#ifndef UMIGV_RANGES_DETAIL_ZIPPED_RANGE_HPP
+#define UMIGV_RANGES_DETAIL_ZIPPED_RANGE_HPP
+
+#include "../traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+template <typename T, typename S>
+struct is_random_access_zip;
+
+template <typename T, std::size_t ...Is>
+struct is_random_access_zip<T, std::index_sequence<Is...>>
+: conjunction<is_random_access_iterator<std::tuple_element_t<Is, T>>...> { };
+
+constexpr bool variadic_or() noexcept {
+    return false;
+}
+
+template <typename ...Ts>
+constexpr bool variadic_or(bool value, Ts ...rest) noexcept {
+    return value || variadic_or(rest...);
+}
+
+// a zip of single pass or bidirectional iterators steps each of them and
+// ends as soon as any one of them reaches its end
+template <typename T, typename S, bool = is_random_access_zip<T, S>::value>
+class ZipCursor;
+
+template <typename T, std::size_t ...Is>
+class ZipCursor<T, std::index_sequence<Is...>, false> {
+public:
+    using reference =
+        std::tuple<iterator_reference_t<std::tuple_element_t<Is, T>>...>;
+
+    constexpr ZipCursor(const T &currents, const T&)
+    noexcept(std::is_nothrow_copy_constructible<T>::value)
+    : currents_{ currents } { }
+
+    constexpr reference dereference() const {
+        return reference{ (*std::get<Is>(currents_))... };
+    }
+
+    constexpr void increment() {
+        using ExpanderT = int[];
+        (void) ExpanderT{ 0, (++std::get<Is>(currents_), 0)... };
+    }
+
+    constexpr bool equal(const ZipCursor &other) const {
+        return variadic_or(
+            (std::get<Is>(currents_) == std::get<Is>(other.currents_))...
+        );
+    }
+
+    constexpr const T& currents() const noexcept {
+        return currents_;
+    }
+
+private:
+    T currents_;
+};
+
+// when every input is random access the common length is computed once and
+// all inputs are addressed by a single index, so ending is one comparison
+template <typename T, std::size_t ...Is>
+class ZipCursor<T, std::index_sequence<Is...>, true> {
+public:
+    using reference =
+        std::tuple<iterator_reference_t<std::tuple_element_t<Is, T>>...>;
+
+    constexpr ZipCursor(const T &firsts, std::ptrdiff_t index)
+    noexcept(std::is_nothrow_copy_constructible<T>::value)
+    : firsts_{ firsts }, index_{ index } { }
+
+    constexpr static std::ptrdiff_t size(const T &firsts, const T &lasts) {
+        return std::min({ static_cast<std::ptrdiff_t>(
+            std::get<Is>(lasts) - std::get<Is>(firsts)
+        )... });
+    }
+
+    constexpr reference dereference() const {
+        return reference{ (*(std::get<Is>(firsts_) + index_))... };
+    }
+
+    constexpr void increment() noexcept {
+        ++index_;
+    }
+
+    constexpr void advance(std::ptrdiff_t n) noexcept {
+        index_ += n;
+    }
+
+    constexpr bool equal(const ZipCursor &other) const noexcept {
+        return index_ == other.index_;
+    }
+
+    constexpr std::ptrdiff_t index() const noexcept {
+        return index_;
+    }
+
+private:
+    T firsts_;
+    std::ptrdiff_t index_;
+};
+
+template <typename T, typename S, bool = is_random_access_zip<T, S>::value>
+class ZipBounds {
+public:
+    using CursorT = ZipCursor<T, S>;
+
+    constexpr ZipBounds(const T &firsts, const T &lasts)
+    noexcept(std::is_nothrow_copy_constructible<T>::value)
+    : firsts_{ firsts }, lasts_{ lasts } { }
+
+    constexpr CursorT first() const {
+        return { firsts_, lasts_ };
+    }
+
+    constexpr CursorT last() const {
+        return { lasts_, lasts_ };
+    }
+
+private:
+    T firsts_;
+    T lasts_;
+};
+
+template <typename T, std::size_t ...Is>
+class ZipBounds<T, std::index_sequence<Is...>, true> {
+public:
+    using CursorT = ZipCursor<T, std::index_sequence<Is...>>;
+
+    constexpr ZipBounds(const T &firsts, const T &lasts)
+    : firsts_{ firsts }, size_{ CursorT::size(firsts, lasts) } { }
+
+    constexpr CursorT first() const {
+        return { firsts_, 0 };
+    }
+
+    constexpr CursorT last() const {
+        return { firsts_, size_ };
+    }
+
+    constexpr std::ptrdiff_t size() const noexcept {
+        return size_;
+    }
+
+    constexpr std::pair<ZipBounds, ZipBounds> split_at(std::ptrdiff_t n) const {
+        const T middles{ (std::get<Is>(firsts_) + n)... };
+
+        return { ZipBounds{ firsts_, n }, ZipBounds{ middles, size_ - n } };
+    }
+
+private:
+    constexpr ZipBounds(const T &firsts, std::ptrdiff_t size)
+    noexcept(std::is_nothrow_copy_constructible<T>::value)
+    : firsts_{ firsts }, size_{ size } { }
+
+    T firsts_;
+    std::ptrdiff_t size_;
+};
+
+} // namespace detail
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -1,55 +1,71 @@
 #ifndef UMIGV_RANGES_ENUMERATED_RANGE_HPP
 #define UMIGV_RANGES_ENUMERATED_RANGE_HPP
 
+#include "detail/check_policy.hpp"
+#include "detail/fold.hpp"
+#include "detail/sentinel.hpp"
+#include "detail/size_hint.hpp"
+
+#include "check_policy.hpp"
+#include "control_flow.hpp"
 #include "range_fwd.hpp"
+#include "sentinel.hpp"
+#include "size_hint.hpp"
 #include "traits.hpp"
 
 #include <iterator>
-#include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
-#include <type_safe/optional.hpp>
-
 namespace umigv {
 namespace ranges {
 
-template <typename I, typename T>
+template <typename I, typename T, typename C = DefaultChecks>
 class EnumeratedRange;
 
-template <typename I, typename T>
-class EnumeratedRangeIterator {
+template <typename I, typename T, typename C = DefaultChecks>
+class EnumeratedRangeIterator
+: private std::conditional_t<
+    is_random_access_iterator<I>::value,
+    detail::CheckedInterval<I, C::enabled>,
+    detail::CheckedBound<I, C::enabled>
+> {
+    // only random access iterators step back, so only they track the start
+    using BoundT = std::conditional_t<
+        is_random_access_iterator<I>::value,
+        detail::CheckedInterval<I, C::enabled>,
+        detail::CheckedBound<I, C::enabled>
+    >;
+
 public:
     static_assert(is_input_iterator<I>::value,
                   "I must be at least an InputIterator");
-    static_assert(std::is_trivially_destructible<
-                      iterator_reference_t<I>
-                  >::value, "I::reference must be trivially destructible");
-    static_assert(std::is_trivially_destructible<T>::value,
-                  "T must be trivially destructible");
 
-    friend EnumeratedRange<I, T>;
+    friend EnumeratedRange<I, T, C>;
 
     using difference_type = iterator_difference_t<I>;
-    using iterator_category = std::input_iterator_tag;
-    using pointer = const std::pair<T, iterator_reference_t<I>>*;
-    using reference = const std::pair<T, iterator_reference_t<I>>&;
-    using value_type = std::pair<T, iterator_reference_t<I>>;
-
-    reference operator*() const {
-        bounds_check();
-
-        data_.emplace(index_, *current_);
-
-        return data_.value();
-    }
-
-    pointer operator->() const {
-        return std::addressof(**this);
+    using iterator_category = std::conditional_t<
+        is_random_access_iterator<I>::value,
+        std::random_access_iterator_tag,
+        std::conditional_t<
+            is_forward_iterator<I>::value,
+            std::forward_iterator_tag,
+            std::input_iterator_tag
+        >
+    >;
+    using pointer = void;
+    using reference = std::pair<T, iterator_reference_t<I>>;
+    using value_type = std::pair<T, iterator_value_t<I>>;
+
+    constexpr reference operator*() const {
+        bounds_check("EnumeratedRangeIterator::operator*");
+
+        return { index_, *current_ };
     }
 
     constexpr EnumeratedRangeIterator& operator++() {
-        bounds_check();
+        bounds_check("EnumeratedRangeIterator::operator++");
 
         ++index_;
         ++current_;
@@ -65,11 +81,119 @@ public:
         return to_return;
     }
 
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr EnumeratedRangeIterator& operator--() {
+        if (C::enabled && bound().is_begin(current_)) {
+            C::fail("EnumeratedRangeIterator::operator--");
+        }
+
+        --index_;
+        --current_;
+
+        return *this;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr EnumeratedRangeIterator operator--(int) {
+        const auto to_return = *this;
+
+        --*this;
+
+        return to_return;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr EnumeratedRangeIterator& operator+=(difference_type n) {
+        if (C::enabled && (n > bound().remaining(current_)
+                           || n < -bound().preceding(current_))) {
+            C::fail("EnumeratedRangeIterator::operator+=");
+        }
+
+        index_ += static_cast<T>(n);
+        current_ += n;
+
+        return *this;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr EnumeratedRangeIterator& operator-=(difference_type n) {
+        return *this += -n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr reference operator[](difference_type n) const {
+        return *(*this + n);
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr EnumeratedRangeIterator
+    operator+(EnumeratedRangeIterator iter, difference_type n) {
+        return iter += n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr EnumeratedRangeIterator
+    operator+(difference_type n, EnumeratedRangeIterator iter) {
+        return iter += n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr EnumeratedRangeIterator
+    operator-(EnumeratedRangeIterator iter, difference_type n) {
+        return iter -= n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr difference_type
+    operator-(const EnumeratedRangeIterator &lhs,
+              const EnumeratedRangeIterator &rhs) {
+        compatibility_check(lhs, rhs, "EnumeratedRangeIterator::operator-");
+
+        return lhs.current_ - rhs.current_;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator<(const EnumeratedRangeIterator &lhs,
+                                    const EnumeratedRangeIterator &rhs) {
+        compatibility_check(lhs, rhs, "EnumeratedRangeIterator::operator<");
+
+        return lhs.current_ < rhs.current_;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator>(const EnumeratedRangeIterator &lhs,
+                                    const EnumeratedRangeIterator &rhs) {
+        return rhs < lhs;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator<=(const EnumeratedRangeIterator &lhs,
+                                     const EnumeratedRangeIterator &rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator>=(const EnumeratedRangeIterator &lhs,
+                                     const EnumeratedRangeIterator &rhs) {
+        return !(lhs < rhs);
+    }
+
     friend constexpr bool operator==(const EnumeratedRangeIterator &lhs,
                                      const EnumeratedRangeIterator &rhs) {
-        if (!(lhs.last_ == rhs.last_)) {
-            throw std::out_of_range{ "EnumeratedRangeIterator::operator==" };
-        }
+        compatibility_check(lhs, rhs, "EnumeratedRangeIterator::operator==");
 
         return lhs.current_ == rhs.current_;
     }
@@ -79,67 +203,215 @@ public:
         return !(lhs == rhs);
     }
 
+    friend constexpr bool operator==(const EnumeratedRangeIterator &lhs,
+                                     const Sentinel<I> &rhs) {
+        return lhs.current_ == rhs.base();
+    }
+
+    friend constexpr bool operator==(const Sentinel<I> &lhs,
+                                     const EnumeratedRangeIterator &rhs) {
+        return rhs == lhs;
+    }
+
+    friend constexpr bool operator!=(const EnumeratedRangeIterator &lhs,
+                                     const Sentinel<I> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator!=(const Sentinel<I> &lhs,
+                                     const EnumeratedRangeIterator &rhs) {
+        return !(rhs == lhs);
+    }
+
+    template <typename S, typename A, typename G,
+              std::enable_if_t<
+                  detail::is_end_of<S, I, EnumeratedRangeIterator>::value, int
+              > = 0>
+    friend constexpr ControlFlow<A> try_fold(
+        const EnumeratedRangeIterator &first, const S &last, A init, G &g
+    ) {
+        T index = first.index_;
+        const EnumerateStep<G> step{ index, g };
+
+        return detail::do_try_fold(first.current_, base_end(last),
+                                   std::move(init), step);
+    }
+
+    template <typename S, typename J = I,
+              std::enable_if_t<
+                  detail::is_end_of<S, J, EnumeratedRangeIterator>::value
+                  && detail::is_sized<J, J>::value,
+                  int
+              > = 0>
+    friend constexpr difference_type
+    sized_distance(const EnumeratedRangeIterator &first, const S &last) {
+        return detail::do_sized_distance(first.current_, base_end(last));
+    }
+
+    template <typename S,
+              std::enable_if_t<
+                  detail::is_end_of<S, I, EnumeratedRangeIterator>::value, int
+              > = 0>
+    friend constexpr SizeHint size_hint(const EnumeratedRangeIterator &first,
+                                        const S &last) {
+        return detail::do_size_hint(first.current_, base_end(last));
+    }
+
 private:
-    constexpr EnumeratedRangeIterator(const I &current, const I &last)
+    template <typename G>
+    class EnumerateStep {
+    public:
+        constexpr EnumerateStep(T &index, G &g) noexcept
+        : index_(index), g_(g) { }
+
+        template <typename A, typename U>
+        constexpr ControlFlow<A> operator()(A acc, U &&element) const {
+            const T index = index_;
+            ++index_;
+
+            return g_(std::move(acc),
+                      reference{ index, std::forward<U>(element) });
+        }
+
+    private:
+        T &index_;
+        G &g_;
+    };
+
+    constexpr static const I& base_end(const Sentinel<I> &last) noexcept {
+        return last.base();
+    }
+
+    constexpr static const I& base_end(const EnumeratedRangeIterator &last)
+    noexcept {
+        return last.current_;
+    }
+
+    constexpr EnumeratedRangeIterator(const I &first, const I &current,
+                                      const I &last, const T &index)
     noexcept(std::is_nothrow_copy_constructible<I>::value
-             && std::is_nothrow_default_constructible<T>::value)
-    : current_{ current }, last_{ last } { }
+             && std::is_nothrow_copy_constructible<T>::value)
+    : BoundT{ first, last }, current_{ current }, index_{ index } { }
+
+    constexpr const BoundT& bound() const noexcept {
+        return *this;
+    }
+
+    constexpr void bounds_check(const char *what) const {
+        if (C::enabled && bound().is_end(current_)) {
+            C::fail(what);
+        }
+    }
 
-    constexpr void bounds_check() const {
-        if (current_ == last_) {
-            throw std::out_of_range{ "EnumeratedRangeIterator::bounds_check" };
+    constexpr static void
+    compatibility_check(const EnumeratedRangeIterator &lhs,
+                        const EnumeratedRangeIterator &rhs, const char *what) {
+        if (C::enabled && !lhs.bound().is_compatible(rhs.bound())) {
+            C::fail(what);
         }
     }
 
     I current_;
-    I last_;
-    T index_{ };
-    mutable type_safe::optional<std::pair<T, iterator_reference_t<I>>> data_;
+    T index_;
 };
 
-template <typename I, typename T>
-class EnumeratedRange : public Range<EnumeratedRange<I, T>> {
+template <typename I, typename T, typename C>
+class EnumeratedRange : public Range<EnumeratedRange<I, T, C>> {
 public:
+    using check_policy = typename RangeTraits<EnumeratedRange>::check_policy;
     using difference_type =
         typename RangeTraits<EnumeratedRange>::difference_type;
     using iterator = typename RangeTraits<EnumeratedRange>::iterator;
     using pointer = typename RangeTraits<EnumeratedRange>::pointer;
     using reference = typename RangeTraits<EnumeratedRange>::reference;
+    using sentinel = typename RangeTraits<EnumeratedRange>::sentinel;
     using value_type = typename RangeTraits<EnumeratedRange>::value_type;
 
     constexpr EnumeratedRange(const I &first, const I &last)
-    noexcept(std::is_nothrow_copy_constructible<I>::value)
-    : first_{ first }, last_{ last } { }
+    noexcept(std::is_nothrow_copy_constructible<I>::value
+             && std::is_nothrow_default_constructible<T>::value)
+    : EnumeratedRange{ first, last, T{ } } { }
 
-    constexpr EnumeratedRangeIterator<I, T> begin() const
+    constexpr EnumeratedRange(const I &first, const I &last, const T &offset)
     noexcept(std::is_nothrow_copy_constructible<I>::value
-             && std::is_nothrow_default_constructible<T>::value) {
-        return { first_, last_ };
+             && std::is_nothrow_copy_constructible<T>::value)
+    : first_{ first }, last_{ last }, offset_{ offset } { }
+
+    constexpr iterator begin() const
+    noexcept(std::is_nothrow_copy_constructible<I>::value
+             && std::is_nothrow_copy_constructible<T>::value) {
+        return { first_, first_, last_, offset_ };
     }
 
-    constexpr EnumeratedRangeIterator<I, T> end() const
+    // only random access iterators can step back from the end, so only they
+    // need the index of the end position
+    constexpr iterator end() const
     noexcept(std::is_nothrow_copy_constructible<I>::value
-             && std::is_nothrow_default_constructible<T>::value) {
-        return { last_, last_ };
+             && std::is_nothrow_copy_constructible<T>::value) {
+        return { first_, last_, last_, end_index() };
+    }
+
+    constexpr sentinel end_sentinel() const
+    noexcept(std::is_nothrow_copy_constructible<I>::value) {
+        return sentinel{ last_ };
+    }
+
+    // the second half continues counting where the first one stops
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr std::pair<EnumeratedRange, EnumeratedRange>
+    split_at(difference_type n) const {
+        if (C::enabled && (n < 0 || n > last_ - first_)) {
+            C::fail("EnumeratedRange::split_at");
+        }
+
+        const I middle = first_ + n;
+
+        return { EnumeratedRange{ first_, middle, offset_ },
+                 EnumeratedRange{ middle, last_,
+                                  static_cast<T>(offset_ + n) } };
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr std::pair<EnumeratedRange, EnumeratedRange> split() const {
+        return split_at((last_ - first_) / 2);
     }
 
 private:
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr T end_index() const noexcept {
+        return static_cast<T>(offset_ + (last_ - first_));
+    }
+
+    template <typename J = I,
+              std::enable_if_t<!is_random_access_iterator<J>::value, int> = 0>
+    constexpr T end_index() const
+    noexcept(std::is_nothrow_copy_constructible<T>::value) {
+        return offset_;
+    }
+
     I first_;
     I last_;
+    T offset_;
 };
 
-template <typename I, typename T>
-struct RangeTraits<EnumeratedRange<I, T>> {
+template <typename I, typename T, typename C>
+struct RangeTraits<EnumeratedRange<I, T, C>> {
+    using check_policy = C;
     using difference_type =
-        iterator_difference_t<EnumeratedRangeIterator<I, T>>;
-    using iterator = EnumeratedRangeIterator<I, T>;
-    using pointer = iterator_pointer_t<EnumeratedRangeIterator<I, T>>;
-    using reference = iterator_reference_t<EnumeratedRangeIterator<I, T>>;
-    using value_type = iterator_value_t<EnumeratedRangeIterator<I, T>>;
+        iterator_difference_t<EnumeratedRangeIterator<I, T, C>>;
+    using iterator = EnumeratedRangeIterator<I, T, C>;
+    using pointer = iterator_pointer_t<EnumeratedRangeIterator<I, T, C>>;
+    using reference = iterator_reference_t<EnumeratedRangeIterator<I, T, C>>;
+    using sentinel = Sentinel<I>;
+    using value_type = iterator_value_t<EnumeratedRangeIterator<I, T, C>>;
 };
 
 template <typename T = std::size_t, typename R>
-EnumeratedRange<begin_result_t<R>, T> enumerate(R &&range)
+EnumeratedRange<begin_result_t<R>, T, range_check_policy_t<R>>
+enumerate(R &&range)
 noexcept(std::is_nothrow_copy_constructible<begin_result_t<R>>::value
          && std::is_nothrow_default_constructible<T>::value) {
     using std::begin;
@@ -1,41 +1,55 @@
 #ifndef UMIGV_RANGES_FILTERED_RANGE_HPP
 #define UMIGV_RANGES_FILTERED_RANGE_HPP
 
+#include "detail/batch.hpp"
+#include "detail/callable_storage.hpp"
 #include "detail/filtered_range.hpp"
+#include "detail/fold.hpp"
+#include "detail/sentinel.hpp"
+#include "detail/size_hint.hpp"
 
 #include "apply.hpp"
+#include "check_policy.hpp"
+#include "control_flow.hpp"
 #include "invoke.hpp"
 #include "range_fwd.hpp"
+#include "sentinel.hpp"
+#include "size_hint.hpp"
 #include "traits.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <type_traits>
+#include <utility>
 
 namespace umigv {
 namespace ranges {
 
-template <typename I, typename P,
+template <typename I, typename P, typename C = DefaultChecks,
           std::enable_if_t<detail::is_filterable<I, P>::value, int> = 0>
 class FilteredRange;
 
-template <typename I, typename P,
+template <typename I, typename P, typename C = DefaultChecks,
           std::enable_if_t<detail::is_filterable<I, P>::value, int> = 0,
           typename = void>
-class FilteredRangeIterator {
+class FilteredRangeIterator : private detail::DereferenceCache<I, P> {
+    using CacheT = detail::DereferenceCache<I, P>;
+
 public:
     using difference_type = iterator_difference_t<I>;
     using iterator_category = std::input_iterator_tag;
-    using pointer = iterator_pointer_t<I>;
-    using reference = iterator_reference_t<I>;
+    using pointer = typename CacheT::pointer;
+    using reference = typename CacheT::reference;
     using value_type = iterator_value_t<I>;
 
-    friend FilteredRange<I, P>;
+    friend FilteredRange<I, P, C>;
 
     constexpr reference operator*() const {
-        if (current_ == last_) {
-            throw std::out_of_range{ "FilteredRangeIterator::operator*" };
+        if (C::enabled && current_ == last()) {
+            C::fail("FilteredRangeIterator::operator*");
         }
 
-        return *current_;
+        return cache().dereference(current_);
     }
 
     constexpr pointer operator->() const {
@@ -43,12 +57,12 @@ public:
     }
 
     constexpr FilteredRangeIterator& operator++() {
-        if (current_ == last_) {
-            throw std::out_of_range{ "FilteredRangeIterator::operator++" };
+        if (C::enabled && current_ == last()) {
+            C::fail("FilteredRangeIterator::operator++");
         }
 
         ++current_;
-        detail::advance(current_, last_, predicate_);
+        cache().advance(current_, last(), predicate());
 
         return *this;
     }
@@ -63,8 +77,8 @@ public:
 
     friend constexpr bool operator==(const FilteredRangeIterator &lhs,
                                      const FilteredRangeIterator &rhs) {
-        if (!(lhs.last_ == rhs.last_)) {
-            throw std::out_of_range{ "FilteredRangeIterator::operator==" };
+        if (C::enabled && !(lhs.last() == rhs.last())) {
+            C::fail("FilteredRangeIterator::operator==");
         }
 
         return lhs.current_ == rhs.current_;
@@ -75,52 +89,273 @@ public:
         return !(lhs == rhs);
     }
 
+    friend constexpr bool operator==(const FilteredRangeIterator &lhs,
+                                     const Sentinel<I> &rhs) {
+        return lhs.current_ == rhs.base();
+    }
+
+    friend constexpr bool operator==(const Sentinel<I> &lhs,
+                                     const FilteredRangeIterator &rhs) {
+        return rhs == lhs;
+    }
+
+    friend constexpr bool operator!=(const FilteredRangeIterator &lhs,
+                                     const Sentinel<I> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator!=(const Sentinel<I> &lhs,
+                                     const FilteredRangeIterator &rhs) {
+        return !(rhs == lhs);
+    }
+
+    template <typename S, typename T, typename G,
+              std::enable_if_t<
+                  detail::is_end_of<S, I, FilteredRangeIterator>::value
+                  && detail::is_const_testable<I, P>::value,
+                  int
+              > = 0>
+    friend constexpr ControlFlow<T> try_fold(const FilteredRangeIterator &first,
+                                             const S &last, T init, G &g) {
+        const I &end = base_end(last);
+
+        if (first.current_ == end) {
+            return ControlFlow<T>::proceed(std::move(init));
+        }
+
+        ControlFlow<T> flow = g(std::move(init), *first);
+
+        if (flow.is_stop()) {
+            return flow;
+        }
+
+        I next = first.current_;
+        ++next;
+
+        const FilterStep<G> step{ first.predicate(), g };
+
+        return detail::do_try_fold(next, end, std::move(flow).value(), step);
+    }
+
+    template <typename S,
+              std::enable_if_t<
+                  detail::is_end_of<S, I, FilteredRangeIterator>::value, int
+              > = 0>
+    friend constexpr SizeHint size_hint(const FilteredRangeIterator &first,
+                                        const S &last) {
+        const I &end = base_end(last);
+
+        return {
+            (first.current_ == end) ? 0u : 1u,
+            detail::do_size_hint(first.current_, end).upper()
+        };
+    }
+
+    // blocks are pulled from the base straight into out and compacted in
+    // place, so only the elements that pass are kept
+    template <typename S,
+              std::enable_if_t<
+                  detail::is_end_of<S, I, FilteredRangeIterator>::value
+                  && detail::is_batch_testable<value_type, P>::value,
+                  int
+              > = 0>
+    friend std::size_t next_batch(FilteredRangeIterator &first, const S &last,
+                                  value_type *out, std::size_t capacity) {
+        const I &end = base_end(last);
+
+        if (capacity == 0 || first.current_ == end) {
+            return 0;
+        }
+
+        out[0] = *first;
+        ++first.current_;
+
+        std::size_t count = 1;
+
+        while (count < capacity && !(first.current_ == end)) {
+            const std::size_t num_pulled = detail::do_next_batch(
+                first.current_, end, out + count,
+                std::min(capacity - count, detail::BATCH_SIZE)
+            );
+
+            count += detail::compact(out + count, num_pulled,
+                                     first.predicate());
+        }
+
+        first.cache().advance(first.current_, first.last(),
+                              first.predicate());
+
+        return count;
+    }
+
 private:
+    template <typename G>
+    class FilterStep {
+    public:
+        constexpr FilterStep(const P &predicate, G &g) noexcept
+        : predicate_(predicate), g_(g) { }
+
+        template <typename T, typename U>
+        constexpr ControlFlow<T> operator()(T acc, U &&element) const {
+            if (!detail::test(predicate_, static_cast<
+                    const std::remove_reference_t<U>&
+                >(element))) {
+                return ControlFlow<T>::proceed(std::move(acc));
+            }
+
+            return g_(std::move(acc), std::forward<U>(element));
+        }
+
+    private:
+        const P &predicate_;
+        G &g_;
+    };
+
+    constexpr static const I& base_end(const Sentinel<I> &last) noexcept {
+        return last.base();
+    }
+
+    constexpr static const I& base_end(const FilteredRangeIterator &last)
+    noexcept {
+        return last.current_;
+    }
+
+    // runs the predicate until the first match, so it throws whatever the
+    // predicate throws
     constexpr FilteredRangeIterator(const I &current, const I &last,
                                     const P &predicate)
-    noexcept(std::is_nothrow_copy_constructible<I>::value
-             && std::is_nothrow_copy_constructible<P>::value)
-    : current_{ current }, last_{ last }, predicate_{ predicate } {
-        detail::advance(current_, last_, predicate_);
+    : current_{ current }, data_{ last, predicate } {
+        cache().advance(current_, data_.first(), data_.second());
+    }
+
+    struct AdvancedTag { };
+
+    constexpr FilteredRangeIterator(AdvancedTag, const I &current,
+                                    const I &last, const P &predicate)
+    : current_{ current }, data_{ last, predicate } {
+        cache().load(current_, data_.first());
+    }
+
+    constexpr CacheT& cache() noexcept {
+        return *this;
+    }
+
+    constexpr const CacheT& cache() const noexcept {
+        return *this;
+    }
+
+    constexpr const I& last() const noexcept {
+        return data_.first();
+    }
+
+    constexpr const P& predicate() const noexcept {
+        return data_.second();
     }
 
     I current_;
-    I last_;
-    P predicate_;
+    detail::CompressedPair<I, P> data_;
 };
 
-template <typename I, typename P,
+// the first call to begin() scans for the first match and remembers it, so
+// later calls are O(1) and do not invoke the predicate again. begin() may be
+// called from several threads at once; calls that race with the first scan
+// scan the range themselves. the match is not looked for again if the
+// underlying elements change, and copies keep it, so after changing them
+// call reset() before iterating again
+template <typename I, typename P, typename C,
           std::enable_if_t<detail::is_filterable<I, P>::value, int>>
-class FilteredRange : public Range<FilteredRange<I, P>> {
+class FilteredRange : public Range<FilteredRange<I, P, C>> {
 public:
+    using check_policy = typename RangeTraits<FilteredRange>::check_policy;
     using difference_type =
         typename RangeTraits<FilteredRange>::difference_type;
     using iterator = typename RangeTraits<FilteredRange>::iterator;
     using pointer = typename RangeTraits<FilteredRange>::pointer;
     using reference = typename RangeTraits<FilteredRange>::reference;
+    using sentinel = typename RangeTraits<FilteredRange>::sentinel;
     using value_type = typename RangeTraits<FilteredRange>::value_type;
 
     constexpr FilteredRange(const I &first, const I &last, const P &predicate)
     noexcept(std::is_nothrow_copy_constructible<I>::value
              && std::is_nothrow_copy_constructible<P>::value)
-    : first_{ first }, last_{ last }, predicate_{ predicate } { }
+    : first_{ first }, data_{ last, predicate } { }
 
-    constexpr iterator begin() const
-    noexcept(std::is_nothrow_copy_constructible<I>::value
-             && std::is_nothrow_copy_constructible<P>::value) {
-        return { first_, last_, predicate_ };
+    iterator begin() const {
+        if (const I *const match = first_.match()) {
+            return { AdvancedTag{ }, *match, data_.first(), data_.second() };
+        }
+
+        const iterator first{ first_.origin(), data_.first(),
+                              data_.second() };
+        first_.publish(first.current_);
+
+        return first;
     }
 
     constexpr iterator end() const
     noexcept(std::is_nothrow_copy_constructible<I>::value
              && std::is_nothrow_copy_constructible<P>::value) {
-        return { last_, last_, predicate_ };
+        return { data_.first(), data_.first(), data_.second() };
+    }
+
+    constexpr sentinel end_sentinel() const
+    noexcept(std::is_nothrow_copy_constructible<I>::value) {
+        return sentinel{ data_.first() };
+    }
+
+    // forgets the first match, so the next call to begin() scans for it
+    // again. must not be called while another thread is calling begin()
+    void reset() noexcept {
+        first_.reset();
+    }
+
+    // n counts positions of the underlying range from where this range
+    // starts, not matching elements and not the cached first match, so
+    // splitting never evaluates the predicate and the halves may hold very
+    // different numbers of elements
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr std::pair<FilteredRange, FilteredRange>
+    split_at(difference_type n) const {
+        const I &origin = first_.origin();
+
+        if (C::enabled && (n < 0 || n > data_.first() - origin)) {
+            C::fail("FilteredRange::split_at");
+        }
+
+        const I middle = origin + n;
+
+        return { FilteredRange{ origin, middle, data_.second() },
+                 FilteredRange{ middle, data_.first(), data_.second() } };
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr std::pair<FilteredRange, FilteredRange> split() const {
+        return split_at((data_.first() - first_.origin()) / 2);
+    }
+
+    // filtering again tests both predicates in one pass over the original
+    // range rather than wrapping this range
+    template <typename Q>
+    constexpr FilteredRange<
+        I, detail::ConjoinedPredicate<I, P, std::decay_t<Q>>, C
+    > filter(Q &&predicate) const
+    noexcept(std::is_nothrow_copy_constructible<I>::value
+             && std::is_nothrow_copy_constructible<P>::value
+             && std::is_nothrow_constructible<std::decay_t<Q>, Q>::value
+             && std::is_nothrow_copy_constructible<std::decay_t<Q>>::value) {
+        const std::decay_t<Q> second{ std::forward<Q>(predicate) };
+
+        return { first_.origin(), data_.first(),
+                 { data_.second(), second } };
     }
 
 private:
-    I first_;
-    I last_;
-    P predicate_;
+    using AdvancedTag = typename iterator::AdvancedTag;
+
+    mutable detail::FirstMatchCache<I> first_;
+    detail::CompressedPair<I, P> data_;
 };
 
 template <typename R, typename P>
@@ -130,20 +365,24 @@ noexcept(std::is_nothrow_copy_constructible<begin_result_t<R>>::value
     using std::begin;
     using std::end;
 
-    return FilteredRange<begin_result_t<R>, std::decay_t<P>> {
+    return FilteredRange<begin_result_t<R>, std::decay_t<P>,
+                         range_check_policy_t<R>> {
         begin(std::forward<R>(range)),
         end(std::forward<R>(range)),
         std::forward<P>(predicate)
     };
 }
 
-template <typename I, typename P>
-struct RangeTraits<FilteredRange<I, P>> {
-    using difference_type = iterator_difference_t<FilteredRangeIterator<I, P>>;
-    using iterator = FilteredRangeIterator<I, P>;
-    using pointer = iterator_pointer_t<FilteredRangeIterator<I, P>>;
-    using reference = iterator_reference_t<FilteredRangeIterator<I, P>>;
-    using value_type = iterator_value_t<FilteredRangeIterator<I, P>>;
+template <typename I, typename P, typename C>
+struct RangeTraits<FilteredRange<I, P, C>> {
+    using check_policy = C;
+    using difference_type =
+        iterator_difference_t<FilteredRangeIterator<I, P, C>>;
+    using iterator = FilteredRangeIterator<I, P, C>;
+    using pointer = iterator_pointer_t<FilteredRangeIterator<I, P, C>>;
+    using reference = iterator_reference_t<FilteredRangeIterator<I, P, C>>;
+    using sentinel = Sentinel<I>;
+    using value_type = iterator_value_t<FilteredRangeIterator<I, P, C>>;
 };
 
 } // namespae ranges
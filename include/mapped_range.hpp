@@ -1,42 +1,58 @@
 #ifndef UMIGV_RANGES_MAPPED_RANGE_HPP
 #define UMIGV_RANGES_MAPPED_RANGE_HPP
 
+#include "detail/batch.hpp"
+#include "detail/callable_storage.hpp"
+#include "detail/check_policy.hpp"
+#include "detail/fold.hpp"
 #include "detail/mapped_range.hpp"
+#include "detail/sentinel.hpp"
+#include "detail/size_hint.hpp"
 
+#include "check_policy.hpp"
+#include "control_flow.hpp"
 #include "invoke.hpp"
 #include "range_fwd.hpp"
+#include "sentinel.hpp"
+#include "size_hint.hpp"
+#include "traits.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 namespace umigv {
 namespace ranges {
 
-template <typename I, typename F,
+template <typename I, typename F, typename C = DefaultChecks,
           std::enable_if_t<detail::is_mappable<I, F>::value, int> = 0>
 class MappedRange;
 
-template <typename I, typename F,
+template <typename I, typename F, typename C = DefaultChecks,
           std::enable_if_t<detail::is_mappable<I, F>::value, int> = 0>
-class MappedRangeIterator {
+class MappedRangeIterator
+: private detail::checked_bound_t<I, C::enabled> {
+    using BoundT = detail::checked_bound_t<I, C::enabled>;
     using ResultT = detail::map_result_t<I, F>;
 
 public:
     using difference_type = iterator_difference_t<I>;
-    using iterator_category = std::input_iterator_tag;
+    using iterator_category = clamped_iterator_category_t<I>;
     using pointer = std::add_pointer_t<std::remove_reference_t<ResultT>>;
     using reference = ResultT;
     using value_type = std::decay_t<ResultT>;
 
-    friend MappedRange<I, F>;
+    friend MappedRange<I, F, C>;
 
     constexpr reference operator*() const {
-        if (current_ == last_) {
-            throw std::out_of_range{ "MappedRangeIterator::operator*" };
+        if (C::enabled && bound().is_end(current())) {
+            C::fail("MappedRangeIterator::operator*");
         }
 
-        return detail::do_map(current_, f_);
+        return detail::do_map(current(), function());
     }
 
     constexpr pointer operator->() const {
@@ -44,11 +60,11 @@ public:
     }
 
     constexpr MappedRangeIterator& operator++() {
-        if (current_ == last_) {
-            throw std::out_of_range{ "MappedRangeIterator::operator++" };
+        if (C::enabled && bound().is_end(current())) {
+            C::fail("MappedRangeIterator::operator++");
         }
 
-        ++current_;
+        ++current();
 
         return *this;
     }
@@ -61,13 +77,118 @@ public:
         return to_return;
     }
 
+    template <typename J = I,
+              std::enable_if_t<is_bidirectional_iterator<J>::value, int> = 0>
+    constexpr MappedRangeIterator& operator--() {
+        if (C::enabled && bound().is_begin(current())) {
+            C::fail("MappedRangeIterator::operator--");
+        }
+
+        --current();
+
+        return *this;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_bidirectional_iterator<J>::value, int> = 0>
+    constexpr MappedRangeIterator operator--(int) {
+        const MappedRangeIterator to_return = *this;
+
+        --(*this);
+
+        return to_return;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr MappedRangeIterator& operator+=(difference_type n) {
+        if (C::enabled && (n > bound().remaining(current())
+                           || n < -bound().preceding(current()))) {
+            C::fail("MappedRangeIterator::operator+=");
+        }
+
+        current() += n;
+
+        return *this;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr MappedRangeIterator& operator-=(difference_type n) {
+        return *this += -n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr reference operator[](difference_type n) const {
+        return *(*this + n);
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr MappedRangeIterator operator+(MappedRangeIterator iter,
+                                                   difference_type n) {
+        return iter += n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr MappedRangeIterator operator+(difference_type n,
+                                                   MappedRangeIterator iter) {
+        return iter += n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr MappedRangeIterator operator-(MappedRangeIterator iter,
+                                                   difference_type n) {
+        return iter -= n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr difference_type operator-(const MappedRangeIterator &lhs,
+                                               const MappedRangeIterator &rhs) {
+        compatibility_check(lhs, rhs, "MappedRangeIterator::operator-");
+
+        return lhs.current() - rhs.current();
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator<(const MappedRangeIterator &lhs,
+                                    const MappedRangeIterator &rhs) {
+        compatibility_check(lhs, rhs, "MappedRangeIterator::operator<");
+
+        return lhs.current() < rhs.current();
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator>(const MappedRangeIterator &lhs,
+                                    const MappedRangeIterator &rhs) {
+        return rhs < lhs;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator<=(const MappedRangeIterator &lhs,
+                                     const MappedRangeIterator &rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator>=(const MappedRangeIterator &lhs,
+                                     const MappedRangeIterator &rhs) {
+        return !(lhs < rhs);
+    }
+
     friend constexpr bool operator==(const MappedRangeIterator &lhs,
                                      const MappedRangeIterator &rhs) {
-        if (!(lhs.last_ == rhs.last_)) {
-            throw std::out_of_range{ "MappedRangeIterator::operator==" };
-        }
+        compatibility_check(lhs, rhs, "MappedRangeIterator::operator==");
 
-        return lhs.current_ == rhs.current_;
+        return lhs.current() == rhs.current();
     }
 
     friend constexpr bool operator!=(const MappedRangeIterator &lhs,
@@ -75,50 +196,251 @@ public:
         return !(lhs == rhs);
     }
 
+    friend constexpr bool operator==(const MappedRangeIterator &lhs,
+                                     const Sentinel<I> &rhs) {
+        return lhs.current() == rhs.base();
+    }
+
+    friend constexpr bool operator==(const Sentinel<I> &lhs,
+                                     const MappedRangeIterator &rhs) {
+        return rhs == lhs;
+    }
+
+    friend constexpr bool operator!=(const MappedRangeIterator &lhs,
+                                     const Sentinel<I> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator!=(const Sentinel<I> &lhs,
+                                     const MappedRangeIterator &rhs) {
+        return !(rhs == lhs);
+    }
+
+    template <typename S, typename T, typename G,
+              std::enable_if_t<
+                  detail::is_end_of<S, I, MappedRangeIterator>::value, int
+              > = 0>
+    friend constexpr ControlFlow<T> try_fold(const MappedRangeIterator &first,
+                                             const S &last, T init, G &g) {
+        const MapStep<G> step{ first.function(), g };
+
+        return detail::do_try_fold(first.current(), base_end(last),
+                                   std::move(init), step);
+    }
+
+    template <typename S, typename J = I,
+              std::enable_if_t<
+                  detail::is_end_of<S, J, MappedRangeIterator>::value
+                  && detail::is_sized<J, J>::value,
+                  int
+              > = 0>
+    friend constexpr difference_type
+    sized_distance(const MappedRangeIterator &first, const S &last) {
+        return detail::do_sized_distance(first.current(), base_end(last));
+    }
+
+    template <typename S,
+              std::enable_if_t<
+                  detail::is_end_of<S, I, MappedRangeIterator>::value, int
+              > = 0>
+    friend constexpr SizeHint size_hint(const MappedRangeIterator &first,
+                                        const S &last) {
+        return detail::do_size_hint(first.current(), base_end(last));
+    }
+
+    // a random access base is indexed directly; any other base is read a
+    // block at a time into a staging buffer and f is run over the block
+    template <typename S, typename J = I,
+              std::enable_if_t<
+                  detail::is_end_of<S, J, MappedRangeIterator>::value
+                  && is_random_access_iterator<J>::value,
+                  int
+              > = 0>
+    friend std::size_t next_batch(MappedRangeIterator &first, const S &last,
+                                  value_type *out, std::size_t capacity) {
+        I &current = first.current();
+        const auto count = std::min(
+            capacity, static_cast<std::size_t>(base_end(last) - current)
+        );
+
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = detail::map_value<I>(
+                first.function(), current[static_cast<difference_type>(i)]
+            );
+        }
+
+        current += static_cast<difference_type>(count);
+
+        return count;
+    }
+
+    template <typename S, typename J = I,
+              std::enable_if_t<
+                  detail::is_end_of<S, J, MappedRangeIterator>::value
+                  && !is_random_access_iterator<J>::value
+                  && detail::is_batch_mappable<J, F>::value,
+                  int
+              > = 0>
+    friend std::size_t next_batch(MappedRangeIterator &first, const S &last,
+                                  value_type *out, std::size_t capacity) {
+        using BaseValueT = iterator_value_t<I>;
+
+        BaseValueT stage[detail::BATCH_SIZE];
+        std::size_t count = 0;
+
+        while (count < capacity) {
+            const std::size_t num_staged = detail::do_next_batch(
+                first.current(), base_end(last), stage,
+                std::min(capacity - count, detail::BATCH_SIZE)
+            );
+
+            if (num_staged == 0) {
+                break;
+            }
+
+            for (std::size_t i = 0; i < num_staged; ++i) {
+                out[count + i] = detail::map_value<const BaseValueT*>(
+                    first.function(), static_cast<const BaseValueT&>(stage[i])
+                );
+            }
+
+            count += num_staged;
+        }
+
+        return count;
+    }
+
 private:
-    constexpr MappedRangeIterator(const I &current, const I &last, const F &f)
+    template <typename G>
+    class MapStep {
+    public:
+        constexpr MapStep(const F &f, G &g) noexcept : f_(f), g_(g) { }
+
+        template <typename T, typename U>
+        constexpr ControlFlow<T> operator()(T acc, U &&element) const {
+            return g_(std::move(acc),
+                      detail::map_value<I>(f_, std::forward<U>(element)));
+        }
+
+    private:
+        const F &f_;
+        G &g_;
+    };
+
+    constexpr static const I& base_end(const Sentinel<I> &last) noexcept {
+        return last.base();
+    }
+
+    constexpr static const I& base_end(const MappedRangeIterator &last)
+    noexcept {
+        return last.current();
+    }
+
+    constexpr MappedRangeIterator(const I &first, const I &current,
+                                  const I &last, const F &f)
     noexcept(std::is_nothrow_copy_constructible<I>::value
              && std::is_nothrow_copy_constructible<F>::value)
-    : current_{ current }, last_{ last }, f_{ f } { }
+    : BoundT{ first, last }, data_{ current, f } { }
 
-    I current_;
-    I last_;
-    F f_;
+    constexpr const BoundT& bound() const noexcept {
+        return *this;
+    }
+
+    constexpr I& current() noexcept {
+        return data_.first();
+    }
+
+    constexpr const I& current() const noexcept {
+        return data_.first();
+    }
+
+    constexpr const F& function() const noexcept {
+        return data_.second();
+    }
+
+    constexpr static void compatibility_check(const MappedRangeIterator &lhs,
+                                              const MappedRangeIterator &rhs,
+                                              const char *what) {
+        if (C::enabled && !lhs.bound().is_compatible(rhs.bound())) {
+            C::fail(what);
+        }
+    }
+
+    detail::CompressedPair<I, F> data_;
 };
 
-template <typename I, typename F,
+template <typename I, typename F, typename C,
           std::enable_if_t<detail::is_mappable<I, F>::value, int>>
-class MappedRange : public Range<MappedRange<I, F>> {
-    using IteratorT = MappedRangeIterator<I, F>;
-
+class MappedRange : public Range<MappedRange<I, F, C>> {
 public:
+    using check_policy = typename RangeTraits<MappedRange>::check_policy;
     using difference_type = typename RangeTraits<MappedRange>::difference_type;
     using iterator = typename RangeTraits<MappedRange>::iterator;
     using pointer = typename RangeTraits<MappedRange>::pointer;
     using reference = typename RangeTraits<MappedRange>::reference;
+    using sentinel = typename RangeTraits<MappedRange>::sentinel;
     using value_type = typename RangeTraits<MappedRange>::value_type;
 
     constexpr MappedRange(const I &first, const I &last, const F &f)
     noexcept(std::is_nothrow_copy_constructible<I>::value
              && std::is_nothrow_copy_constructible<F>::value)
-    : first_{ first }, last_{ last }, f_{ f } { }
+    : first_{ first }, data_{ last, f } { }
 
     constexpr iterator begin() const
     noexcept(std::is_nothrow_copy_constructible<I>::value
              && std::is_nothrow_copy_constructible<F>::value) {
-        return { first_, last_, f_ };
+        return { first_, first_, data_.first(), data_.second() };
     }
 
     constexpr iterator end() const
     noexcept(std::is_nothrow_copy_constructible<I>::value
              && std::is_nothrow_copy_constructible<F>::value) {
-        return { last_, last_, f_ };
+        return { first_, data_.first(), data_.first(), data_.second() };
+    }
+
+    constexpr sentinel end_sentinel() const
+    noexcept(std::is_nothrow_copy_constructible<I>::value) {
+        return sentinel{ data_.first() };
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr std::pair<MappedRange, MappedRange>
+    split_at(difference_type n) const {
+        if (C::enabled && (n < 0 || n > data_.first() - first_)) {
+            C::fail("MappedRange::split_at");
+        }
+
+        const I middle = first_ + n;
+
+        return { MappedRange{ first_, middle, data_.second() },
+                 MappedRange{ middle, data_.first(), data_.second() } };
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr std::pair<MappedRange, MappedRange> split() const {
+        return split_at((data_.first() - first_) / 2);
+    }
+
+    // mapping again composes the functions rather than wrapping this range,
+    // so a chain of maps always iterates the original range directly
+    template <typename G>
+    constexpr MappedRange<
+        I, detail::ComposedMap<I, iterator, F, std::decay_t<G>>, C
+    > map(G &&g) const
+    noexcept(std::is_nothrow_copy_constructible<I>::value
+             && std::is_nothrow_copy_constructible<F>::value
+             && std::is_nothrow_constructible<std::decay_t<G>, G>::value
+             && std::is_nothrow_copy_constructible<std::decay_t<G>>::value) {
+        const std::decay_t<G> second{ std::forward<G>(g) };
+
+        return { first_, data_.first(), { data_.second(), second } };
     }
 
 private:
     I first_;
-    I last_;
-    F f_;
+    detail::CompressedPair<I, F> data_;
 };
 
 template <typename R, typename F>
@@ -128,20 +450,24 @@ noexcept(std::is_nothrow_copy_constructible<begin_result_t<R>>::value
     using std::begin;
     using std::end;
 
-    return MappedRange<begin_result_t<R>, std::decay_t<F>>{
+    return MappedRange<begin_result_t<R>, std::decay_t<F>,
+                       range_check_policy_t<R>>{
         begin(std::forward<R>(range)),
         end(std::forward<R>(range)),
         std::forward<F>(f),
     };
 }
 
-template <typename I, typename F>
-struct RangeTraits<MappedRange<I, F>> {
-    using difference_type = iterator_difference_t<MappedRangeIterator<I, F>>;
-    using iterator = MappedRangeIterator<I, F>;
-    using pointer = iterator_pointer_t<MappedRangeIterator<I, F>>;
-    using reference = iterator_reference_t<MappedRangeIterator<I, F>>;
-    using value_type = iterator_value_t<MappedRangeIterator<I, F>>;
+template <typename I, typename F, typename C>
+struct RangeTraits<MappedRange<I, F, C>> {
+    using check_policy = C;
+    using difference_type =
+        iterator_difference_t<MappedRangeIterator<I, F, C>>;
+    using iterator = MappedRangeIterator<I, F, C>;
+    using pointer = iterator_pointer_t<MappedRangeIterator<I, F, C>>;
+    using reference = iterator_reference_t<MappedRangeIterator<I, F, C>>;
+    using sentinel = Sentinel<I>;
+    using value_type = iterator_value_t<MappedRangeIterator<I, F, C>>;
 };
 
 } // namespace ranges
@@ -0,0 +1,157 @@
+#ifndef UMIGV_RANGES_MONOTONIC_ARENA_HPP
+#define UMIGV_RANGES_MONOTONIC_ARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace umigv {
+namespace ranges {
+
+// hands out memory by bumping a pointer through blocks that double in size.
+// deallocation does nothing; reset() releases everything at once and keeps
+// only the largest block, so an arena that is reset once per frame stops
+// allocating after it has grown to fit a whole frame. not thread safe
+class MonotonicArena {
+public:
+    // block_size is the size of the first block the arena allocates
+    explicit MonotonicArena(std::size_t block_size = 4096)
+    : next_block_size_{ std::max(block_size, std::size_t{ 1 }) } { }
+
+    MonotonicArena(const MonotonicArena &other) = delete;
+
+    MonotonicArena& operator=(const MonotonicArena &other) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment) {
+        void *allocated = try_allocate(size, alignment);
+
+        if (!allocated) {
+            if (size > std::numeric_limits<std::size_t>::max() - alignment) {
+                throw std::bad_alloc{ };
+            }
+
+            grow(size + alignment);
+            allocated = try_allocate(size, alignment);
+        }
+
+        return allocated;
+    }
+
+    void deallocate(void*, std::size_t, std::size_t) noexcept { }
+
+    void reset() noexcept {
+        if (blocks_.empty()) {
+            return;
+        }
+
+        std::swap(blocks_.front(), blocks_.back());
+        blocks_.erase(blocks_.begin() + 1, blocks_.end());
+
+        current_ = blocks_.front().data.get();
+        remaining_ = blocks_.front().size;
+    }
+
+    // the number of bytes in the blocks the arena holds
+    std::size_t capacity() const noexcept {
+        std::size_t total = 0;
+
+        for (const Block &block : blocks_) {
+            total += block.size;
+        }
+
+        return total;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t size;
+    };
+
+    void* try_allocate(std::size_t size, std::size_t alignment) noexcept {
+        void *first = current_;
+        std::size_t space = remaining_;
+
+        if (!first || !std::align(alignment, size, first, space)) {
+            return nullptr;
+        }
+
+        current_ = static_cast<unsigned char*>(first) + size;
+        remaining_ = space - size;
+
+        return first;
+    }
+
+    void grow(std::size_t min_size) {
+        const std::size_t size = std::max(next_block_size_, min_size);
+
+        blocks_.push_back(Block{
+            std::unique_ptr<unsigned char[]>(new unsigned char[size]), size
+        });
+
+        current_ = blocks_.back().data.get();
+        remaining_ = size;
+        next_block_size_ =
+            (size > std::numeric_limits<std::size_t>::max() / 2) ? size
+                                                                 : 2 * size;
+    }
+
+    std::vector<Block> blocks_;
+    unsigned char *current_ = nullptr;
+    std::size_t remaining_ = 0;
+    std::size_t next_block_size_;
+};
+
+// a standard allocator that draws from a MonotonicArena, which must outlive
+// every container using it
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator(MonotonicArena &arena) noexcept : arena_{ &arena } { }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept
+    : arena_{ &other.arena() } { }
+
+    T* allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length{ };
+        }
+
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept {
+        arena_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    MonotonicArena& arena() const noexcept {
+        return *arena_;
+    }
+
+private:
+    MonotonicArena *arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T> &lhs,
+                const ArenaAllocator<U> &rhs) noexcept {
+    return &lhs.arena() == &rhs.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T> &lhs,
+                const ArenaAllocator<U> &rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
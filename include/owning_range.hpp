@@ -0,0 +1,340 @@
+#ifndef UMIGV_RANGES_OWNING_RANGE_HPP
+#define UMIGV_RANGES_OWNING_RANGE_HPP
+
+#include "detail/fold.hpp"
+
+#include "check_policy.hpp"
+#include "control_flow.hpp"
+#include "range_fwd.hpp"
+#include "traits.hpp"
+
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+namespace detail {
+
+// containers passed as rvalues would be destroyed before the adaptors built
+// on top of them are used, so they are moved into an owning range instead.
+// ranges of this library are views and are adapted as they are
+template <typename R>
+struct is_owned_on_adapt
+: std::integral_constant<
+    bool,
+    !std::is_lvalue_reference<R>::value
+    && !std::is_base_of<Range<remove_cvref_t<R>>, remove_cvref_t<R>>::value
+> { };
+
+template <typename I, bool IsMove>
+struct owning_reference {
+    using type = iterator_reference_t<I>;
+};
+
+// only elements the base iterator refers to are moved from; values that the
+// base produces on dereference are already temporaries
+template <typename I>
+struct owning_reference<I, true> {
+    using type = std::conditional_t<
+        std::is_lvalue_reference<iterator_reference_t<I>>::value,
+        std::remove_reference_t<iterator_reference_t<I>>&&,
+        iterator_reference_t<I>
+    >;
+};
+
+} // namespace detail
+
+// an iterator into a container that it shares ownership of, so every
+// adaptor holding one keeps the container alive. when IsMove is true, the
+// elements are yielded as rvalues and may be moved from by whatever consumes
+// them; filter predicates are still shown them as lvalues
+template <typename I, typename R, bool IsMove = false>
+class OwningIterator {
+public:
+    using difference_type = iterator_difference_t<I>;
+    using iterator_category = clamped_iterator_category_t<I>;
+    using pointer = iterator_pointer_t<I>;
+    using reference = typename detail::owning_reference<I, IsMove>::type;
+    using value_type = iterator_value_t<I>;
+
+    OwningIterator(const I &base, std::shared_ptr<R> owner)
+    noexcept(std::is_nothrow_copy_constructible<I>::value)
+    : base_{ base }, owner_{ std::move(owner) } { }
+
+    constexpr reference operator*() const {
+        return static_cast<reference>(*base_);
+    }
+
+    constexpr pointer operator->() const {
+        return std::addressof(*base_);
+    }
+
+    constexpr OwningIterator& operator++() {
+        ++base_;
+
+        return *this;
+    }
+
+    constexpr OwningIterator operator++(int) {
+        const OwningIterator to_return = *this;
+
+        ++*this;
+
+        return to_return;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_bidirectional_iterator<J>::value, int> = 0>
+    constexpr OwningIterator& operator--() {
+        --base_;
+
+        return *this;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_bidirectional_iterator<J>::value, int> = 0>
+    constexpr OwningIterator operator--(int) {
+        const OwningIterator to_return = *this;
+
+        --*this;
+
+        return to_return;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr OwningIterator& operator+=(difference_type n) {
+        base_ += n;
+
+        return *this;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr OwningIterator& operator-=(difference_type n) {
+        base_ -= n;
+
+        return *this;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr reference operator[](difference_type n) const {
+        return static_cast<reference>(base_[n]);
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr OwningIterator operator+(OwningIterator iter,
+                                              difference_type n) {
+        return iter += n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr OwningIterator operator+(difference_type n,
+                                              OwningIterator iter) {
+        return iter += n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr OwningIterator operator-(OwningIterator iter,
+                                              difference_type n) {
+        return iter -= n;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr difference_type operator-(const OwningIterator &lhs,
+                                               const OwningIterator &rhs) {
+        return lhs.base_ - rhs.base_;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator<(const OwningIterator &lhs,
+                                    const OwningIterator &rhs) {
+        return lhs.base_ < rhs.base_;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator>(const OwningIterator &lhs,
+                                    const OwningIterator &rhs) {
+        return rhs < lhs;
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator<=(const OwningIterator &lhs,
+                                     const OwningIterator &rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    friend constexpr bool operator>=(const OwningIterator &lhs,
+                                     const OwningIterator &rhs) {
+        return !(lhs < rhs);
+    }
+
+    friend constexpr bool operator==(const OwningIterator &lhs,
+                                     const OwningIterator &rhs)
+    noexcept(is_nothrow_equality_comparable<I>::value) {
+        return lhs.base_ == rhs.base_;
+    }
+
+    friend constexpr bool operator!=(const OwningIterator &lhs,
+                                     const OwningIterator &rhs)
+    noexcept(is_nothrow_equality_comparable<I>::value) {
+        return !(lhs == rhs);
+    }
+
+    // folds run over the base iterators, so the loop does not touch the
+    // reference count
+    template <typename T, typename G>
+    friend constexpr ControlFlow<T> try_fold(const OwningIterator &first,
+                                             const OwningIterator &last,
+                                             T init, G &g) {
+        const ReferenceStep<G> step{ g };
+
+        return detail::do_try_fold(first.base_, last.base_, std::move(init),
+                                   step);
+    }
+
+private:
+    template <typename G>
+    class ReferenceStep {
+    public:
+        constexpr explicit ReferenceStep(G &g) noexcept : g_(g) { }
+
+        template <typename T, typename U>
+        constexpr ControlFlow<T> operator()(T acc, U &&element) const {
+            return g_(std::move(acc),
+                      static_cast<reference>(std::forward<U>(element)));
+        }
+
+    private:
+        G &g_;
+    };
+
+    I base_;
+    std::shared_ptr<R> owner_;
+};
+
+// copying the elements out does not change where they live
+template <typename I, typename R>
+struct is_contiguous_iterator<OwningIterator<I, R, false>, true>
+: is_contiguous_iterator<I> { };
+
+// holds a container moved out of an rvalue; copies of the range, the halves
+// it is split into and every iterator taken from them share the container,
+// which is destroyed along with the last of them
+template <typename R, typename C = DefaultChecks, bool IsMove = false>
+class OwningRange : public Range<OwningRange<R, C, IsMove>> {
+public:
+    using check_policy = typename RangeTraits<OwningRange>::check_policy;
+    using difference_type = typename RangeTraits<OwningRange>::difference_type;
+    using iterator = typename RangeTraits<OwningRange>::iterator;
+    using pointer = typename RangeTraits<OwningRange>::pointer;
+    using reference = typename RangeTraits<OwningRange>::reference;
+    using sentinel = typename RangeTraits<OwningRange>::sentinel;
+    using value_type = typename RangeTraits<OwningRange>::value_type;
+
+    explicit OwningRange(R &&range)
+    : OwningRange{ std::make_shared<R>(std::move(range)) } { }
+
+    iterator begin() const
+    noexcept(std::is_nothrow_copy_constructible<iterator>::value) {
+        return first_;
+    }
+
+    iterator end() const
+    noexcept(std::is_nothrow_copy_constructible<iterator>::value) {
+        return last_;
+    }
+
+    sentinel end_sentinel() const
+    noexcept(std::is_nothrow_copy_constructible<iterator>::value) {
+        return last_;
+    }
+
+    template <typename J = iterator,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    std::pair<OwningRange, OwningRange> split_at(difference_type n) const {
+        if (C::enabled && (n < 0 || n > last_ - first_)) {
+            C::fail("OwningRange::split_at");
+        }
+
+        const iterator middle = first_ + n;
+
+        return { OwningRange{ first_, middle }, OwningRange{ middle, last_ } };
+    }
+
+    template <typename J = iterator,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    std::pair<OwningRange, OwningRange> split() const {
+        return split_at((last_ - first_) / 2);
+    }
+
+private:
+    explicit OwningRange(const std::shared_ptr<R> &owner)
+    : first_{ begin_of(*owner), owner }, last_{ end_of(*owner), owner } { }
+
+    OwningRange(const iterator &first, const iterator &last)
+    noexcept(std::is_nothrow_copy_constructible<iterator>::value)
+    : first_{ first }, last_{ last } { }
+
+    static begin_result_t<R&> begin_of(R &range) {
+        using std::begin;
+
+        return begin(range);
+    }
+
+    static begin_result_t<R&> end_of(R &range) {
+        using std::end;
+
+        return end(range);
+    }
+
+    iterator first_;
+    iterator last_;
+};
+
+// moves the container into a range that yields its elements as rvalues, so
+// adaptors and collect move them rather than copy them. the elements can be
+// consumed only once
+template <typename R,
+          std::enable_if_t<!std::is_lvalue_reference<R>::value, int> = 0>
+OwningRange<std::decay_t<R>, DefaultChecks, true> into_iter(R &&range) {
+    return OwningRange<std::decay_t<R>, DefaultChecks, true>{
+        std::move(range)
+    };
+}
+
+template <typename C, typename R,
+          std::enable_if_t<is_check_policy<C>::value
+                           && !std::is_lvalue_reference<R>::value, int> = 0>
+OwningRange<std::decay_t<R>, C, true> into_iter(R &&range) {
+    return OwningRange<std::decay_t<R>, C, true>{ std::move(range) };
+}
+
+template <typename R, typename C, bool IsMove>
+struct RangeTraits<OwningRange<R, C, IsMove>> {
+    using check_policy = C;
+    using difference_type =
+        iterator_difference_t<OwningIterator<begin_result_t<R&>, R, IsMove>>;
+    using iterator = OwningIterator<begin_result_t<R&>, R, IsMove>;
+    using pointer = iterator_pointer_t<iterator>;
+    using reference = iterator_reference_t<iterator>;
+    using sentinel = iterator;
+    using value_type = iterator_value_t<iterator>;
+};
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef UMIGV_RANGES_PAR_MAPPED_RANGE_HPP
+#define UMIGV_RANGES_PAR_MAPPED_RANGE_HPP
+
+#include "detail/callable_storage.hpp"
+#include "detail/mapped_range.hpp"
+#include "detail/par_mapped_range.hpp"
+#include "detail/postfix_proxy.hpp"
+
+#include "check_policy.hpp"
+#include "range_fwd.hpp"
+#include "thread_pool.hpp"
+#include "traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+
+template <typename I, typename F, typename C = DefaultChecks,
+          std::enable_if_t<detail::is_mappable<I, F>::value, int> = 0>
+class ParMappedRange;
+
+template <typename I, typename F, typename C = DefaultChecks>
+class ParMappedRangeIterator {
+    using ChannelT = detail::ParMapChannel<I, F>;
+    using ResultT = detail::par_map_result_t<I, F>;
+
+public:
+    using difference_type = iterator_difference_t<I>;
+    using iterator_category = std::input_iterator_tag;
+    using pointer = const ResultT*;
+    using reference = const ResultT&;
+    using value_type = ResultT;
+
+    friend ParMappedRange<I, F, C>;
+
+    constexpr ParMappedRangeIterator() noexcept = default;
+
+    reference operator*() const {
+        if (C::enabled && !channel_) {
+            C::fail("ParMappedRangeIterator::operator*");
+        }
+
+        return channel_->current();
+    }
+
+    pointer operator->() const {
+        return std::addressof(**this);
+    }
+
+    ParMappedRangeIterator& operator++() {
+        if (C::enabled && !channel_) {
+            C::fail("ParMappedRangeIterator::operator++");
+        }
+
+        if (!channel_->next()) {
+            channel_.reset();
+        }
+
+        return *this;
+    }
+
+    detail::PostfixProxy<ResultT> operator++(int) {
+        detail::PostfixProxy<ResultT> to_return{ **this };
+        ++(*this);
+
+        return to_return;
+    }
+
+    friend bool operator==(const ParMappedRangeIterator &lhs,
+                           const ParMappedRangeIterator &rhs) noexcept {
+        return lhs.channel_ == rhs.channel_;
+    }
+
+    friend bool operator!=(const ParMappedRangeIterator &lhs,
+                           const ParMappedRangeIterator &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+private:
+    explicit ParMappedRangeIterator(std::shared_ptr<ChannelT> channel)
+    noexcept : channel_{ std::move(channel) } { }
+
+    std::shared_ptr<ChannelT> channel_;
+};
+
+// every call to begin() starts num_threads workers that apply f to the
+// elements of the adapted range; f is called concurrently and must be safe
+// to call from several threads at once. a window of zero keeps four elements
+// in flight per worker
+template <typename I, typename F, typename C,
+          std::enable_if_t<detail::is_mappable<I, F>::value, int>>
+class ParMappedRange : public Range<ParMappedRange<I, F, C>> {
+public:
+    using check_policy = typename RangeTraits<ParMappedRange>::check_policy;
+    using difference_type =
+        typename RangeTraits<ParMappedRange>::difference_type;
+    using iterator = typename RangeTraits<ParMappedRange>::iterator;
+    using pointer = typename RangeTraits<ParMappedRange>::pointer;
+    using reference = typename RangeTraits<ParMappedRange>::reference;
+    using sentinel = typename RangeTraits<ParMappedRange>::sentinel;
+    using value_type = typename RangeTraits<ParMappedRange>::value_type;
+
+    ParMappedRange(const I &first, const I &last, const F &f,
+                   std::size_t num_threads, std::size_t window)
+    : first_{ first }, data_{ last, f },
+      num_threads_{ std::max(num_threads, std::size_t{ 1 }) },
+      window_{ (window == 0) ? 4 * num_threads_ : window } { }
+
+    iterator begin() const {
+        auto channel = std::make_shared<detail::ParMapChannel<I, F>>(
+            first_, data_.first(), data_.second(), num_threads_, window_
+        );
+
+        if (!channel->next()) {
+            return end();
+        }
+
+        return iterator{ std::move(channel) };
+    }
+
+    iterator end() const noexcept {
+        return iterator{ };
+    }
+
+    sentinel end_sentinel() const noexcept {
+        return end();
+    }
+
+    std::size_t num_threads() const noexcept {
+        return num_threads_;
+    }
+
+    std::size_t window() const noexcept {
+        return window_;
+    }
+
+private:
+    I first_;
+    detail::CompressedPair<I, F> data_;
+    std::size_t num_threads_;
+    std::size_t window_;
+};
+
+template <typename R, typename F>
+ParMappedRange<begin_result_t<R>, std::decay_t<F>, range_check_policy_t<R>>
+par_map(R &&range, F &&f,
+        std::size_t num_threads = ThreadPool::default_num_threads(),
+        std::size_t window = 0) {
+    using std::begin;
+    using std::end;
+
+    return { begin(std::forward<R>(range)), end(std::forward<R>(range)),
+             std::forward<F>(f), num_threads, window };
+}
+
+template <typename I, typename F, typename C>
+struct RangeTraits<ParMappedRange<I, F, C>> {
+    using check_policy = C;
+    using difference_type = iterator_difference_t<I>;
+    using iterator = ParMappedRangeIterator<I, F, C>;
+    using pointer = iterator_pointer_t<iterator>;
+    using reference = iterator_reference_t<iterator>;
+    using sentinel = iterator;
+    using value_type = iterator_value_t<iterator>;
+};
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
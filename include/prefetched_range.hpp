@@ -0,0 +1,169 @@
+#ifndef UMIGV_RANGES_PREFETCHED_RANGE_HPP
+#define UMIGV_RANGES_PREFETCHED_RANGE_HPP
+
+#include "detail/postfix_proxy.hpp"
+#include "detail/prefetched_range.hpp"
+
+#include "check_policy.hpp"
+#include "range_fwd.hpp"
+#include "traits.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+
+template <typename I, typename C = DefaultChecks>
+class PrefetchedRange;
+
+template <typename T, typename C = DefaultChecks>
+class PrefetchedRangeIterator {
+    using ChannelT = detail::PrefetchChannel<T>;
+
+public:
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::input_iterator_tag;
+    using pointer = const T*;
+    using reference = const T&;
+    using value_type = T;
+
+    template <typename I, typename D>
+    friend class PrefetchedRange;
+
+    constexpr PrefetchedRangeIterator() noexcept = default;
+
+    reference operator*() const {
+        if (C::enabled && !channel_) {
+            C::fail("PrefetchedRangeIterator::operator*");
+        }
+
+        return channel_->current();
+    }
+
+    pointer operator->() const {
+        return std::addressof(**this);
+    }
+
+    PrefetchedRangeIterator& operator++() {
+        if (C::enabled && !channel_) {
+            C::fail("PrefetchedRangeIterator::operator++");
+        }
+
+        if (!channel_->next()) {
+            channel_.reset();
+        }
+
+        return *this;
+    }
+
+    detail::PostfixProxy<T> operator++(int) {
+        detail::PostfixProxy<T> to_return{ **this };
+        ++(*this);
+
+        return to_return;
+    }
+
+    friend bool operator==(const PrefetchedRangeIterator &lhs,
+                           const PrefetchedRangeIterator &rhs) noexcept {
+        return lhs.channel_ == rhs.channel_;
+    }
+
+    friend bool operator!=(const PrefetchedRangeIterator &lhs,
+                           const PrefetchedRangeIterator &rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+private:
+    explicit PrefetchedRangeIterator(std::shared_ptr<ChannelT> channel)
+    noexcept : channel_{ std::move(channel) } { }
+
+    std::shared_ptr<ChannelT> channel_;
+};
+
+// every call to begin() starts a new thread that runs the adapted range and
+// buffers up to capacity elements ahead of the consumer. all copies of an
+// iterator share one position; the last one to be destroyed stops the thread
+template <typename I, typename C>
+class PrefetchedRange : public Range<PrefetchedRange<I, C>> {
+public:
+    using check_policy = typename RangeTraits<PrefetchedRange>::check_policy;
+    using difference_type =
+        typename RangeTraits<PrefetchedRange>::difference_type;
+    using iterator = typename RangeTraits<PrefetchedRange>::iterator;
+    using pointer = typename RangeTraits<PrefetchedRange>::pointer;
+    using reference = typename RangeTraits<PrefetchedRange>::reference;
+    using sentinel = typename RangeTraits<PrefetchedRange>::sentinel;
+    using value_type = typename RangeTraits<PrefetchedRange>::value_type;
+
+    PrefetchedRange(const I &first, const I &last, std::size_t capacity)
+    : first_{ first }, last_{ last }, capacity_{ checked_capacity(capacity) }
+    { }
+
+    iterator begin() const {
+        auto channel = std::make_shared<detail::PrefetchChannel<value_type>>(
+            first_, last_, capacity_
+        );
+
+        if (!channel->next()) {
+            return end();
+        }
+
+        return iterator{ std::move(channel) };
+    }
+
+    iterator end() const noexcept {
+        return iterator{ };
+    }
+
+    sentinel end_sentinel() const noexcept {
+        return end();
+    }
+
+    std::size_t capacity() const noexcept {
+        return capacity_;
+    }
+
+private:
+    static std::size_t checked_capacity(std::size_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument{ "PrefetchedRange::PrefetchedRange" };
+        }
+
+        return capacity;
+    }
+
+    I first_;
+    I last_;
+    std::size_t capacity_;
+};
+
+template <typename R>
+PrefetchedRange<begin_result_t<R>, range_check_policy_t<R>>
+prefetch(R &&range, std::size_t capacity) {
+    using std::begin;
+    using std::end;
+
+    return { begin(std::forward<R>(range)), end(std::forward<R>(range)),
+             capacity };
+}
+
+template <typename I, typename C>
+struct RangeTraits<PrefetchedRange<I, C>> {
+    using check_policy = C;
+    using difference_type = iterator_difference_t<I>;
+    using iterator = PrefetchedRangeIterator<iterator_value_t<I>, C>;
+    using pointer = iterator_pointer_t<iterator>;
+    using reference = iterator_reference_t<iterator>;
+    using sentinel = iterator;
+    using value_type = iterator_value_t<iterator>;
+};
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -1,17 +1,38 @@
 #ifndef UMIGV_RANGES_RANGE_HPP
 #define UMIGV_RANGES_RANGE_HPP
 
+#include "detail/collect.hpp"
+#include "detail/fold.hpp"
+#include "detail/parallel.hpp"
+#include "detail/reduce.hpp"
+#include "detail/search.hpp"
+#include "detail/size_hint.hpp"
+
+#include "batch.hpp"
+#include "check_policy.hpp"
 #include "collect.hpp"
 #include "const_iterator.hpp"
+#include "control_flow.hpp"
 #include "enumerated_range.hpp"
 #include "filtered_range.hpp"
 #include "mapped_range.hpp"
+#include "owning_range.hpp"
+#include "par_mapped_range.hpp"
+#include "prefetched_range.hpp"
 #include "range_adapter.hpp"
 #include "range_fwd.hpp"
+#include "size_hint.hpp"
+#include "thread_pool.hpp"
 #include "zipped_range.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+#include <type_safe/optional.hpp>
 
 namespace umigv {
 namespace ranges {
@@ -19,31 +40,56 @@ namespace ranges {
 template <typename R>
 class Range {
 public:
+    using check_policy = typename RangeTraits<R>::check_policy;
     using const_iterator = ConstIterator<typename RangeTraits<R>::iterator>;
     using difference_type = typename RangeTraits<R>::difference_type;
     using iterator = typename RangeTraits<R>::iterator;
     using pointer = typename RangeTraits<R>::pointer;
     using reference = typename RangeTraits<R>::reference;
+    using sentinel = typename RangeTraits<R>::sentinel;
     using value_type = typename RangeTraits<R>::value_type;
 
-    constexpr iterator begin() const noexcept {
+    // adaptors such as filter and prefetch run user code to find their
+    // first element, so these throw whatever the derived range throws
+    constexpr iterator begin() const
+    noexcept(noexcept(std::declval<const R&>().begin())) {
         return as_base().begin();
     }
 
-    constexpr const_iterator cbegin() const noexcept {
+    constexpr const_iterator cbegin() const
+    noexcept(noexcept(std::declval<const R&>().begin())) {
         return const_iterator{ begin() };
     }
 
-    constexpr iterator end() const noexcept {
+    constexpr iterator end() const
+    noexcept(noexcept(std::declval<const R&>().end())) {
         return as_base().end();
     }
 
-    constexpr const_iterator cend() const noexcept {
+    constexpr const_iterator cend() const
+    noexcept(noexcept(std::declval<const R&>().end())) {
         return const_iterator{ end() };
     }
 
+    constexpr sentinel end_sentinel() const
+    noexcept(noexcept(std::declval<const R&>().end_sentinel())) {
+        return as_base().end_sentinel();
+    }
+
+    template <typename J = iterator,
+              std::enable_if_t<detail::is_sized<J, sentinel>::value, int> = 0>
+    constexpr std::size_t size() const {
+        return static_cast<std::size_t>(
+            detail::do_sized_distance(begin(), end_sentinel())
+        );
+    }
+
+    constexpr SizeHint size_hint() const {
+        return detail::do_size_hint(begin(), end_sentinel());
+    }
+
     template <typename F>
-    constexpr MappedRange<iterator, F> map(F &&f)
+    constexpr MappedRange<iterator, std::decay_t<F>, check_policy> map(F &&f)
     noexcept(noexcept(
         ::umigv::ranges::map(std::declval<Range>(), std::declval<F>())
     )) {
@@ -51,7 +97,8 @@ public:
     }
 
     template <typename P>
-    constexpr FilteredRange<iterator, P> filter(P &&predicate)
+    constexpr FilteredRange<iterator, std::decay_t<P>, check_policy>
+    filter(P &&predicate)
     noexcept(noexcept(
         ::umigv::ranges::filter(std::declval<Range>(), std::declval<P>())
     )) {
@@ -59,7 +106,7 @@ public:
     }
 
     template <typename T = std::size_t>
-    constexpr EnumeratedRange<iterator, T> enumerate()
+    constexpr EnumeratedRange<iterator, T, check_policy> enumerate()
     noexcept(noexcept(
         ::umigv::ranges::enumerate<T>(std::declval<Range>())
     )) {
@@ -74,8 +121,161 @@ public:
         return ::umigv::ranges::zip(*this, std::forward<Rs>(ranges)...);
     }
 
+    // f is applied on worker threads while later elements are still being
+    // pulled; the results come out in the order of the elements
+    template <typename F>
+    ParMappedRange<iterator, std::decay_t<F>, check_policy>
+    par_map(F &&f,
+            std::size_t num_threads = ThreadPool::default_num_threads(),
+            std::size_t window = 0) const {
+        return ::umigv::ranges::par_map(*this, std::forward<F>(f),
+                                        num_threads, window);
+    }
+
+    // the adaptors before prefetch run on a separate producer thread while
+    // the ones after it consume up to capacity buffered elements
+    PrefetchedRange<iterator, check_policy>
+    prefetch(std::size_t capacity) const {
+        return ::umigv::ranges::prefetch(*this, capacity);
+    }
+
+    template <typename F>
+    constexpr void for_each(F &&f) const {
+        detail::ForEachStep<F> step{ f };
+
+        detail::do_try_fold(begin(), end_sentinel(), detail::Unit{ }, step);
+    }
+
+    template <typename T, typename F>
+    constexpr T fold(T init, F &&f) const {
+        detail::FoldStep<F> step{ f };
+
+        return detail::do_try_fold(begin(), end_sentinel(), std::move(init),
+                                   step).value();
+    }
+
+    template <typename T, typename F>
+    constexpr ControlFlow<T> try_fold(T init, F &&f) const {
+        return detail::do_try_fold(begin(), end_sentinel(), std::move(init), f);
+    }
+
+    // arithmetic elements are reduced in several independent lanes over
+    // blocks of elements; sum() adds them up in a fixed order that does not
+    // depend on the source, so its result is reproducible
+    value_type sum() const {
+        return detail::do_sum(begin(), end_sentinel());
+    }
+
+    type_safe::optional<value_type> min() const {
+        return detail::do_extremum<detail::Less>(begin(), end_sentinel());
+    }
+
+    type_safe::optional<value_type> max() const {
+        return detail::do_extremum<detail::Greater>(begin(), end_sentinel());
+    }
+
+    type_safe::optional<std::pair<value_type, value_type>> minmax() const {
+        return detail::do_minmax(begin(), end_sentinel());
+    }
+
+    std::size_t count() const {
+        return detail::do_count(begin(), end_sentinel());
+    }
+
+    // find and position accept either a predicate or a value to compare the
+    // elements against. all of these stop at the first element that decides
+    // the result; a contiguous range of arithmetic elements is searched for
+    // a value of its own type in blocks, and byte ranges with memchr
+    template <typename P,
+              std::enable_if_t<
+                  detail::is_search_predicate<P, reference>::value, int
+              > = 0>
+    type_safe::optional<value_type> find(const P &predicate) const {
+        return detail::do_find_if(begin(), end_sentinel(), predicate);
+    }
+
+    template <typename T,
+              std::enable_if_t<
+                  !detail::is_search_predicate<T, reference>::value, int
+              > = 0>
+    type_safe::optional<value_type> find(const T &value) const {
+        return detail::do_find(begin(), end_sentinel(), value);
+    }
+
+    template <typename P,
+              std::enable_if_t<
+                  detail::is_search_predicate<P, reference>::value, int
+              > = 0>
+    type_safe::optional<std::size_t> position(const P &predicate) const {
+        return detail::do_position_if(begin(), end_sentinel(), predicate);
+    }
+
+    template <typename T,
+              std::enable_if_t<
+                  !detail::is_search_predicate<T, reference>::value, int
+              > = 0>
+    type_safe::optional<std::size_t> position(const T &value) const {
+        return detail::do_position(begin(), end_sentinel(), value);
+    }
+
+    template <typename P>
+    bool any(const P &predicate) const {
+        return detail::do_any(begin(), end_sentinel(), predicate);
+    }
+
+    template <typename P>
+    bool all(const P &predicate) const {
+        return detail::do_all(begin(), end_sentinel(), predicate);
+    }
+
+    template <typename P>
+    bool none(const P &predicate) const {
+        return !any(predicate);
+    }
+
+    // the parallel operations need random access to split the range; the
+    // functions they are given are called concurrently from several threads
+    template <typename F, typename J = iterator,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    void par_for_each(F &&f,
+                      const Parallelism &parallelism = Parallelism{ }) const {
+        const iterator first = begin();
+
+        detail::par_for_each(first, static_cast<std::size_t>(end() - first),
+                             f, parallelism);
+    }
+
+    // f must be associative and accept both (T, reference) and (T, T)
+    template <typename T, typename F, typename J = iterator,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    T par_reduce(T identity, F &&f,
+                 const Parallelism &parallelism = Parallelism{ }) const {
+        const iterator first = begin();
+
+        return detail::par_reduce(first,
+                                  static_cast<std::size_t>(end() - first),
+                                  std::move(identity), f, parallelism);
+    }
+
+    template <typename J = iterator,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    std::vector<value_type>
+    par_collect(const Parallelism &parallelism = Parallelism{ }) const {
+        const iterator first = begin();
+
+        return detail::par_collect<value_type>(
+            first, static_cast<std::size_t>(end() - first), parallelism
+        );
+    }
+
+    BatchReader<iterator, sentinel> batches() const {
+        return { begin(), end_sentinel() };
+    }
+
     constexpr Collectable<iterator> collect() const {
-        return { begin(), end() };
+        const iterator first = begin();
+
+        return { first, end(), detail::do_size_hint(first, end_sentinel()) };
     }
 
     template <
@@ -86,11 +286,106 @@ public:
         > = 0
     >
     constexpr C collect() const {
-        return C(begin(), end());
+        return collect();
+    }
+
+    // builds the container with an allocator, such as an ArenaAllocator, and
+    // then extends it with the elements of this range
+    template <typename C, typename A,
+              std::enable_if_t<
+                  std::is_constructible<C, const A&>::value
+                  && detail::is_extendable<C, iterator>::value,
+                  int
+              > = 0>
+    C collect(const A &allocator) const {
+        C collected(allocator);
+        extend(collected);
+
+        return collected;
+    }
+
+    // the range must hold exactly as many elements as the array. when that
+    // is not checked, elements past the end of the array are not copied and
+    // elements that the range is missing are value-initialized
+    template <
+        typename C,
+        std::enable_if_t<
+            detail::is_std_array<C>::value
+            && detail::is_sized<iterator, sentinel>::value,
+            int
+        > = 0
+    >
+    C collect() const {
+        constexpr std::size_t N = std::tuple_size<C>::value;
+
+        const iterator first = begin();
+        const auto size = static_cast<std::size_t>(
+            detail::do_sized_distance(first, end_sentinel())
+        );
+
+        if (check_policy::enabled && size != N) {
+            check_policy::fail("Range::collect");
+        }
+
+        C collected;
+
+        if (size <= N) {
+            detail::do_copy(first, end_sentinel(), collected.data());
+            std::fill(collected.begin() + size, collected.end(),
+                      typename C::value_type{ });
+        } else {
+            iterator current = first;
+
+            for (typename C::value_type &element : collected) {
+                element = *current;
+                ++current;
+            }
+        }
+
+        return collected;
+    }
+
+    // appends every element to the end of container. room is reserved up
+    // front when the container supports it, so a container that is reused
+    // keeps its capacity and does not allocate again once it is large enough
+    template <typename C,
+              std::enable_if_t<
+                  detail::is_extendable<C, iterator>::value, int
+              > = 0>
+    C& extend(C &container) const {
+        const iterator first = begin();
+        detail::do_extend(container, first, end_sentinel(),
+                          detail::do_size_hint(first, end_sentinel()));
+
+        return container;
+    }
+
+    // replaces the contents of container with the elements of this range,
+    // keeping whatever capacity it already has
+    template <typename C,
+              std::enable_if_t<
+                  detail::is_extendable<C, iterator>::value, int
+              > = 0>
+    C& collect_into(C &container) const {
+        container.clear();
+
+        return extend(container);
+    }
+
+    // assigns every element to an output iterator and returns it advanced
+    // past the last element written
+    template <typename O>
+    O copy(O out) const {
+        return detail::do_copy(begin(), end_sentinel(), std::move(out));
     }
 
-    constexpr RangeAdapter<ConstIterator<iterator>> as_const() const noexcept {
-        return ::umigv::ranges::adapt(cbegin(), cend());
+    constexpr RangeAdapter<ConstIterator<iterator>, check_policy>
+    as_const() const
+    noexcept(noexcept(::umigv::ranges::adapt<check_policy>(
+        std::declval<const Range&>().cbegin(),
+        std::declval<const Range&>().cend()
+    ))) {
+        return ::umigv::ranges::adapt<check_policy>(cbegin(), cend());
     }
 
 private:
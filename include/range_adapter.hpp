@@ -1,24 +1,30 @@
 #ifndef UMIGV_RANGES_RANGE_ADAPTER_HPP
 #define UMIGV_RANGES_RANGE_ADAPTER_HPP
 
+#include "check_policy.hpp"
+#include "owning_range.hpp"
 #include "range_fwd.hpp"
 #include "traits.hpp"
 
 #include <initializer_list>
 #include <iterator>
 #include <type_traits>
+#include <utility>
 
 namespace umigv {
 namespace ranges {
 
-template <typename I, std::enable_if_t<is_iterator<I>::value, int> = 0>
-class RangeAdapter : public Range<RangeAdapter<I>> {
+template <typename I, typename C = DefaultChecks,
+          std::enable_if_t<is_iterator<I>::value, int> = 0>
+class RangeAdapter : public Range<RangeAdapter<I, C>> {
 public:
+    using check_policy = typename RangeTraits<RangeAdapter>::check_policy;
     using difference_type =
         typename RangeTraits<RangeAdapter>::difference_type;
     using iterator = typename RangeTraits<RangeAdapter>::iterator;
     using pointer = typename RangeTraits<RangeAdapter>::pointer;
     using reference = typename RangeTraits<RangeAdapter>::reference;
+    using sentinel = typename RangeTraits<RangeAdapter>::sentinel;
     using value_type = typename RangeTraits<RangeAdapter>::value_type;
 
     constexpr RangeAdapter(I first, I last)
@@ -32,6 +38,32 @@ public:
         return last_;
     }
 
+    constexpr sentinel end_sentinel() const noexcept {
+        return last_;
+    }
+
+    // both halves are independent ranges and may be consumed on different
+    // threads; the second half starts at the nth element
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr std::pair<RangeAdapter, RangeAdapter>
+    split_at(difference_type n) const {
+        if (C::enabled && (n < 0 || n > last_ - first_)) {
+            C::fail("RangeAdapter::split_at");
+        }
+
+        const I middle = first_ + n;
+
+        return { RangeAdapter{ first_, middle },
+                 RangeAdapter{ middle, last_ } };
+    }
+
+    template <typename J = I,
+              std::enable_if_t<is_random_access_iterator<J>::value, int> = 0>
+    constexpr std::pair<RangeAdapter, RangeAdapter> split() const {
+        return split_at((last_ - first_) / 2);
+    }
+
 private:
     I first_;
     I last_;
@@ -43,7 +75,8 @@ noexcept {
     return { first, last };
 }
 
-template <typename R>
+template <typename R,
+          std::enable_if_t<!detail::is_owned_on_adapt<R>::value, int> = 0>
 constexpr RangeAdapter<begin_result_t<R>> adapt(R &&r) noexcept {
     using std::begin;
     using std::end;
@@ -51,6 +84,12 @@ constexpr RangeAdapter<begin_result_t<R>> adapt(R &&r) noexcept {
     return { begin(std::forward<R>(r)), end(std::forward<R>(r)) };
 }
 
+template <typename R,
+          std::enable_if_t<detail::is_owned_on_adapt<R>::value, int> = 0>
+OwningRange<std::decay_t<R>> adapt(R &&r) {
+    return OwningRange<std::decay_t<R>>{ std::move(r) };
+}
+
 template <typename T>
 constexpr RangeAdapter<begin_result_t<std::initializer_list<T>>>
 adapt(std::initializer_list<T> list) noexcept {
@@ -60,12 +99,47 @@ adapt(std::initializer_list<T> list) noexcept {
     return { begin(list), end(list) };
 }
 
-template <typename I>
-struct RangeTraits<RangeAdapter<I>> {
+template <typename C, typename I,
+          std::enable_if_t<is_check_policy<C>::value, int> = 0>
+constexpr RangeAdapter<I, C> adapt(I first, I last) noexcept {
+    return { first, last };
+}
+
+template <typename C, typename R,
+          std::enable_if_t<is_check_policy<C>::value
+                           && !detail::is_owned_on_adapt<R>::value, int> = 0>
+constexpr RangeAdapter<begin_result_t<R>, C> adapt(R &&r) noexcept {
+    using std::begin;
+    using std::end;
+
+    return { begin(std::forward<R>(r)), end(std::forward<R>(r)) };
+}
+
+template <typename C, typename R,
+          std::enable_if_t<is_check_policy<C>::value
+                           && detail::is_owned_on_adapt<R>::value, int> = 0>
+OwningRange<std::decay_t<R>, C> adapt(R &&r) {
+    return OwningRange<std::decay_t<R>, C>{ std::move(r) };
+}
+
+template <typename C, typename T,
+          std::enable_if_t<is_check_policy<C>::value, int> = 0>
+constexpr RangeAdapter<begin_result_t<std::initializer_list<T>>, C>
+adapt(std::initializer_list<T> list) noexcept {
+    using std::begin;
+    using std::end;
+
+    return { begin(list), end(list) };
+}
+
+template <typename I, typename C>
+struct RangeTraits<RangeAdapter<I, C>> {
+    using check_policy = C;
     using difference_type = iterator_difference_t<I>;
     using iterator = I;
     using pointer = iterator_pointer_t<I>;
     using reference = iterator_reference_t<I>;
+    using sentinel = I;
     using value_type = iterator_value_t<I>;
 };
 
@@ -9,10 +9,12 @@ class Range;
 
 template <typename R>
 struct RangeTraits {
+    using check_policy = typename R::check_policy;
     using difference_type = typename R::difference_type;
     using iterator = typename R::iterator;
     using pointer = typename R::pointer;
     using reference = typename R::reference;
+    using sentinel = typename R::sentinel;
     using value_type = typename R::value_type;
 };
 
@@ -1,14 +1,26 @@
 #ifndef UMIGV_RANGES_RANGES_HPP
 #define UMIGV_RANGES_RANGES_HPP
 
+#include "batch.hpp"
+#include "check_policy.hpp"
 #include "collect.hpp"
 #include "const_iterator.hpp"
+#include "control_flow.hpp"
 #include "counting_range.hpp"
 #include "enumerated_range.hpp"
 #include "filtered_range.hpp"
 #include "mapped_range.hpp"
+#include "monotonic_arena.hpp"
+#include "owning_range.hpp"
+#include "par_mapped_range.hpp"
+#include "prefetched_range.hpp"
 #include "range.hpp"
 #include "range_adapter.hpp"
+#include "sentinel.hpp"
+#include "size_hint.hpp"
+#include "small_vector.hpp"
+#include "static_vector.hpp"
+#include "thread_pool.hpp"
 #include "zipped_range.hpp"
 
 #endif
@@ -0,0 +1,26 @@
+#ifndef UMIGV_RANGES_SENTINEL_HPP
+#define UMIGV_RANGES_SENTINEL_HPP
+
+#include <type_traits>
+
+namespace umigv {
+namespace ranges {
+
+template <typename S>
+class Sentinel {
+public:
+    constexpr explicit Sentinel(const S &base)
+    noexcept(std::is_nothrow_copy_constructible<S>::value) : base_{ base } { }
+
+    constexpr const S& base() const noexcept {
+        return base_;
+    }
+
+private:
+    S base_;
+};
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
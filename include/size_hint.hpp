@@ -0,0 +1,49 @@
+#ifndef UMIGV_RANGES_SIZE_HINT_HPP
+#define UMIGV_RANGES_SIZE_HINT_HPP
+
+#include <cstddef>
+#include <utility>
+
+#include <type_safe/optional.hpp>
+
+namespace umigv {
+namespace ranges {
+
+// bounds on the number of elements left in a range; upper is empty when no
+// bound is known. a range of known size has equal, present bounds. not a
+// literal type, since type_safe::optional is not one
+class SizeHint {
+public:
+    SizeHint(std::size_t lower,
+             type_safe::optional<std::size_t> upper) noexcept
+    : lower_{ lower }, upper_(std::move(upper)) { }
+
+    static SizeHint exact(std::size_t size) noexcept {
+        return { size, size };
+    }
+
+    static SizeHint unknown() noexcept {
+        return { 0, type_safe::nullopt };
+    }
+
+    std::size_t lower() const noexcept {
+        return lower_;
+    }
+
+    const type_safe::optional<std::size_t>& upper() const noexcept {
+        return upper_;
+    }
+
+    bool is_exact() const noexcept {
+        return upper_.has_value() && upper_.value() == lower_;
+    }
+
+private:
+    std::size_t lower_;
+    type_safe::optional<std::size_t> upper_;
+};
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
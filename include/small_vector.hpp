@@ -0,0 +1,335 @@
+#ifndef UMIGV_RANGES_SMALL_VECTOR_HPP
+#define UMIGV_RANGES_SMALL_VECTOR_HPP
+
+#include "traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+
+// a vector that keeps up to N elements in storage inside the object and
+// moves them to the heap once it grows past N. a moved-from vector that was
+// on the heap gives up its allocation instead of moving the elements
+template <typename T, std::size_t N>
+class SmallVector {
+public:
+    using const_iterator = const T*;
+    using const_pointer = const T*;
+    using const_reference = const T&;
+    using difference_type = std::ptrdiff_t;
+    using iterator = T*;
+    using pointer = T*;
+    using reference = T&;
+    using size_type = std::size_t;
+    using value_type = T;
+
+    SmallVector() noexcept { }
+
+    // constructors that can fail partway delegate to the default
+    // constructor, so the destructor cleans up whatever was constructed and
+    // frees the heap block
+    template <typename I,
+              std::enable_if_t<is_input_iterator<I>::value, int> = 0>
+    SmallVector(I first, I last) : SmallVector() {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    SmallVector(std::initializer_list<T> list) : SmallVector() {
+        reserve(list.size());
+
+        for (const T &element : list) {
+            emplace_back(element);
+        }
+    }
+
+    SmallVector(const SmallVector &other) : SmallVector() {
+        reserve(other.size());
+
+        for (const T &element : other) {
+            emplace_back(element);
+        }
+    }
+
+    SmallVector(SmallVector &&other)
+    noexcept(std::is_nothrow_move_constructible<T>::value) : SmallVector() {
+        take(other);
+    }
+
+    ~SmallVector() {
+        clear();
+        deallocate();
+    }
+
+    SmallVector& operator=(const SmallVector &other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size());
+
+            for (const T &element : other) {
+                emplace_back(element);
+            }
+        }
+
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector &&other)
+    noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            clear();
+            deallocate();
+            take(other);
+        }
+
+        return *this;
+    }
+
+    reference operator[](size_type n) noexcept {
+        return data_[n];
+    }
+
+    const_reference operator[](size_type n) const noexcept {
+        return data_[n];
+    }
+
+    reference front() noexcept {
+        return *begin();
+    }
+
+    const_reference front() const noexcept {
+        return *begin();
+    }
+
+    reference back() noexcept {
+        return *(end() - 1);
+    }
+
+    const_reference back() const noexcept {
+        return *(end() - 1);
+    }
+
+    pointer data() noexcept {
+        return data_;
+    }
+
+    const_pointer data() const noexcept {
+        return data_;
+    }
+
+    iterator begin() noexcept {
+        return data_;
+    }
+
+    const_iterator begin() const noexcept {
+        return data_;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    const_iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    // true while the elements are stored inside the object
+    bool is_inline() const noexcept {
+        return data_ == inline_data();
+    }
+
+    void reserve(size_type n) {
+        if (n > capacity_) {
+            T *const allocated = std::allocator<T>{ }.allocate(n);
+
+            try {
+                relocate(allocated, n);
+            } catch (...) {
+                std::allocator<T>{ }.deallocate(allocated, n);
+
+                throw;
+            }
+        }
+    }
+
+    void clear() noexcept {
+        destroy(begin(), end());
+        size_ = 0;
+    }
+
+    // when the vector is full, the new element is constructed in the new
+    // storage before the old elements move, so args may refer to them
+    template <typename ...As>
+    reference emplace_back(As &&...args) {
+        if (size_ < capacity_) {
+            ::new (static_cast<void*>(end())) T(std::forward<As>(args)...);
+        } else {
+            const size_type new_capacity = std::max(2 * capacity_,
+                                                    size_type{ 1 });
+            T *const allocated = std::allocator<T>{ }.allocate(new_capacity);
+            T *const constructed = allocated + size_;
+
+            try {
+                ::new (static_cast<void*>(constructed))
+                    T(std::forward<As>(args)...);
+
+                try {
+                    relocate(allocated, new_capacity);
+                } catch (...) {
+                    constructed->~T();
+
+                    throw;
+                }
+            } catch (...) {
+                std::allocator<T>{ }.deallocate(allocated, new_capacity);
+
+                throw;
+            }
+        }
+
+        ++size_;
+
+        return back();
+    }
+
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept {
+        back().~T();
+        --size_;
+    }
+
+    iterator insert(const_iterator position, const T &value) {
+        return emplace(position, value);
+    }
+
+    iterator insert(const_iterator position, T &&value) {
+        return emplace(position, std::move(value));
+    }
+
+    template <typename ...As>
+    iterator emplace(const_iterator position, As &&...args) {
+        const auto index = position - begin();
+        emplace_back(std::forward<As>(args)...);
+
+        const iterator inserted = begin() + index;
+        std::rotate(inserted, end() - 1, end());
+
+        return inserted;
+    }
+
+    friend bool operator==(const SmallVector &lhs, const SmallVector &rhs) {
+        return lhs.size() == rhs.size()
+               && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool operator!=(const SmallVector &lhs, const SmallVector &rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    T* inline_data() noexcept {
+        return reinterpret_cast<T*>(storage_);
+    }
+
+    const T* inline_data() const noexcept {
+        return reinterpret_cast<const T*>(storage_);
+    }
+
+    // moves the elements into allocated, which holds new_capacity elements
+    // and becomes the storage of this vector. elements whose move could
+    // throw are copied, so if relocating fails, this vector is left as it
+    // was and the caller still owns allocated
+    void relocate(T *allocated, size_type new_capacity) {
+        size_type num_relocated = 0;
+
+        try {
+            for (; num_relocated < size_; ++num_relocated) {
+                ::new (static_cast<void*>(allocated + num_relocated))
+                    T(std::move_if_noexcept(data_[num_relocated]));
+            }
+        } catch (...) {
+            destroy(allocated, allocated + num_relocated);
+
+            throw;
+        }
+
+        destroy(begin(), end());
+        deallocate();
+        data_ = allocated;
+        capacity_ = new_capacity;
+    }
+
+    static void destroy(T *first, T *last) noexcept {
+        for (; first != last; ++first) {
+            first->~T();
+        }
+    }
+
+    void deallocate() noexcept {
+        if (!is_inline()) {
+            std::allocator<T>{ }.deallocate(data_, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+        }
+    }
+
+    void take(SmallVector &other) {
+        if (!other.is_inline()) {
+            data_ = std::exchange(other.data_, other.inline_data());
+            capacity_ = std::exchange(other.capacity_, N);
+            size_ = std::exchange(other.size_, 0);
+
+            return;
+        }
+
+        for (T &element : other) {
+            ::new (static_cast<void*>(end())) T(std::move(element));
+            ++size_;
+        }
+    }
+
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage_[(N == 0) ? 1 : N];
+    T *data_ = inline_data();
+    size_type capacity_ = N;
+    size_type size_ = 0;
+};
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
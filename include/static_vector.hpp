@@ -0,0 +1,236 @@
+#ifndef UMIGV_RANGES_STATIC_VECTOR_HPP
+#define UMIGV_RANGES_STATIC_VECTOR_HPP
+
+#include "check_policy.hpp"
+#include "traits.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace umigv {
+namespace ranges {
+
+// a vector that keeps up to N elements in storage inside the object and
+// never allocates. growing past N is reported through the check policy;
+// with checks disabled it is undefined behavior
+template <typename T, std::size_t N, typename C = DefaultChecks>
+class StaticVector {
+public:
+    using const_iterator = const T*;
+    using const_pointer = const T*;
+    using const_reference = const T&;
+    using difference_type = std::ptrdiff_t;
+    using iterator = T*;
+    using pointer = T*;
+    using reference = T&;
+    using size_type = std::size_t;
+    using value_type = T;
+
+    StaticVector() noexcept { }
+
+    // constructors that can fail partway delegate to the default
+    // constructor, so the destructor cleans up whatever was constructed
+    template <typename I,
+              std::enable_if_t<is_input_iterator<I>::value, int> = 0>
+    StaticVector(I first, I last) : StaticVector() {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    StaticVector(std::initializer_list<T> list)
+    : StaticVector(list.begin(), list.end()) { }
+
+    StaticVector(const StaticVector &other)
+    : StaticVector(other.begin(), other.end()) { }
+
+    StaticVector(StaticVector &&other)
+    noexcept(std::is_nothrow_move_constructible<T>::value) : StaticVector() {
+        for (T &element : other) {
+            ::new (static_cast<void*>(end())) T(std::move(element));
+            ++size_;
+        }
+    }
+
+    ~StaticVector() {
+        clear();
+    }
+
+    StaticVector& operator=(const StaticVector &other) {
+        if (this != &other) {
+            clear();
+
+            for (const T &element : other) {
+                emplace_back(element);
+            }
+        }
+
+        return *this;
+    }
+
+    StaticVector& operator=(StaticVector &&other)
+    noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            clear();
+
+            for (T &element : other) {
+                ::new (static_cast<void*>(end())) T(std::move(element));
+                ++size_;
+            }
+        }
+
+        return *this;
+    }
+
+    reference operator[](size_type n) noexcept {
+        return data()[n];
+    }
+
+    const_reference operator[](size_type n) const noexcept {
+        return data()[n];
+    }
+
+    reference front() noexcept {
+        return *begin();
+    }
+
+    const_reference front() const noexcept {
+        return *begin();
+    }
+
+    reference back() noexcept {
+        return *(end() - 1);
+    }
+
+    const_reference back() const noexcept {
+        return *(end() - 1);
+    }
+
+    pointer data() noexcept {
+        return reinterpret_cast<T*>(storage_);
+    }
+
+    const_pointer data() const noexcept {
+        return reinterpret_cast<const T*>(storage_);
+    }
+
+    iterator begin() noexcept {
+        return data();
+    }
+
+    const_iterator begin() const noexcept {
+        return data();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    iterator end() noexcept {
+        return data() + size_;
+    }
+
+    const_iterator end() const noexcept {
+        return data() + size_;
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    constexpr static size_type max_size() noexcept {
+        return N;
+    }
+
+    constexpr static size_type capacity() noexcept {
+        return N;
+    }
+
+    void reserve(size_type n) {
+        if (C::enabled && n > N) {
+            C::fail("StaticVector::reserve");
+        }
+    }
+
+    void clear() noexcept {
+        for (T &element : *this) {
+            element.~T();
+        }
+
+        size_ = 0;
+    }
+
+    template <typename ...As>
+    reference emplace_back(As &&...args) {
+        if (C::enabled && size_ == N) {
+            C::fail("StaticVector::emplace_back");
+        }
+
+        ::new (static_cast<void*>(end())) T(std::forward<As>(args)...);
+        ++size_;
+
+        return back();
+    }
+
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept {
+        back().~T();
+        --size_;
+    }
+
+    iterator insert(const_iterator position, const T &value) {
+        return emplace(position, value);
+    }
+
+    iterator insert(const_iterator position, T &&value) {
+        return emplace(position, std::move(value));
+    }
+
+    template <typename ...As>
+    iterator emplace(const_iterator position, As &&...args) {
+        const auto index = position - begin();
+        emplace_back(std::forward<As>(args)...);
+
+        const iterator inserted = begin() + index;
+        std::rotate(inserted, end() - 1, end());
+
+        return inserted;
+    }
+
+    friend bool operator==(const StaticVector &lhs, const StaticVector &rhs) {
+        return lhs.size() == rhs.size()
+               && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool operator!=(const StaticVector &lhs, const StaticVector &rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage_[(N == 0) ? 1 : N];
+    size_type size_ = 0;
+};
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
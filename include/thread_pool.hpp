@@ -0,0 +1,341 @@
+#ifndef UMIGV_RANGES_THREAD_POOL_HPP
+#define UMIGV_RANGES_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace umigv {
+namespace ranges {
+
+// a fixed set of worker threads, each with its own deque of tasks. a worker
+// splits the task it is running in half until it is no larger than the
+// grain, pushing the halves it does not run onto its own deque; idle workers
+// steal the oldest, and therefore largest, task from another deque. a thread
+// that calls parallel_for runs tasks too until the whole job is done, and
+// sleeps while there are none left for it to run
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t num_threads = default_num_threads())
+    : queues_(std::max(num_threads, std::size_t{ 1 }) + 1) {
+        for (auto &queue : queues_) {
+            queue = std::make_unique<Queue>();
+        }
+
+        const auto num_workers = queues_.size() - 1;
+        workers_.reserve(num_workers);
+
+        try {
+            for (std::size_t i = 0; i < num_workers; ++i) {
+                workers_.emplace_back([this, i] { work(i); });
+            }
+        } catch (...) {
+            stop();
+
+            throw;
+        }
+    }
+
+    ThreadPool(const ThreadPool &other) = delete;
+
+    ThreadPool& operator=(const ThreadPool &other) = delete;
+
+    ~ThreadPool() {
+        stop();
+    }
+
+    static std::size_t default_num_threads() noexcept {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    std::size_t size() const noexcept {
+        return workers_.size();
+    }
+
+    // calls body(first, last) on disjoint subranges covering [0, count),
+    // none longer than grain, and returns once all of them have returned.
+    // if any call throws, the remaining subranges are skipped and the first
+    // exception is rethrown here
+    template <typename F>
+    void parallel_for(std::size_t count, std::size_t grain, F &&body) {
+        if (count == 0) {
+            return;
+        }
+
+        Job job{ body, count, std::max(grain, std::size_t{ 1 }) };
+        const std::size_t index = queue_index();
+
+        execute(index, { &job, 0, count });
+
+        while (!job.is_done()) {
+            Task task;
+
+            if (find_task(index, task)) {
+                execute(index, task);
+
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{ sleep_mutex_ };
+            sleep_condition_.wait(lock, [this, &job] {
+                return job.is_done()
+                       || num_queued_.load(std::memory_order_acquire) > 0;
+            });
+        }
+
+        job.rethrow_if_failed();
+    }
+
+private:
+    class Job {
+    public:
+        template <typename F>
+        Job(F &body, std::size_t count, std::size_t grain) noexcept
+        : body_{ static_cast<const void*>(std::addressof(body)) },
+          invoke_{ &invoke_body<F> },
+          remaining_{ count }, grain_{ grain } { }
+
+        std::size_t grain() const noexcept {
+            return grain_;
+        }
+
+        // true if this finished the job, which may be destroyed as soon as
+        // it is finished
+        bool run(std::size_t first, std::size_t last) noexcept {
+            if (!is_failed_.load(std::memory_order_relaxed)) {
+                try {
+                    invoke_(body_, first, last);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock{ exception_mutex_ };
+
+                    if (!exception_) {
+                        exception_ = std::current_exception();
+                        is_failed_.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            return remaining_.fetch_sub(last - first,
+                                        std::memory_order_acq_rel)
+                   == last - first;
+        }
+
+        bool is_done() const noexcept {
+            return remaining_.load(std::memory_order_acquire) == 0;
+        }
+
+        void rethrow_if_failed() const {
+            if (exception_) {
+                std::rethrow_exception(exception_);
+            }
+        }
+
+    private:
+        template <typename F>
+        static void invoke_body(const void *body, std::size_t first,
+                                std::size_t last) {
+            (*static_cast<F*>(const_cast<void*>(body)))(first, last);
+        }
+
+        const void *body_;
+        void (*invoke_)(const void*, std::size_t, std::size_t);
+        std::atomic<std::size_t> remaining_;
+        std::size_t grain_;
+        std::atomic<bool> is_failed_{ false };
+        std::mutex exception_mutex_;
+        std::exception_ptr exception_;
+    };
+
+    struct Task {
+        Job *job;
+        std::size_t first;
+        std::size_t last;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct WorkerSlot {
+        const ThreadPool *pool;
+        std::size_t index;
+    };
+
+    static WorkerSlot& this_worker() noexcept {
+        thread_local WorkerSlot slot{ nullptr, 0 };
+
+        return slot;
+    }
+
+    // threads that are not workers of this pool share the last queue
+    std::size_t queue_index() const noexcept {
+        const WorkerSlot &slot = this_worker();
+
+        return (slot.pool == this) ? slot.index : queues_.size() - 1;
+    }
+
+    void work(std::size_t index) {
+        this_worker() = { this, index };
+
+        while (true) {
+            Task task;
+
+            if (find_task(index, task)) {
+                execute(index, task);
+
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{ sleep_mutex_ };
+            sleep_condition_.wait(lock, [this] {
+                return is_stopping_
+                       || num_queued_.load(std::memory_order_acquire) > 0;
+            });
+
+            if (is_stopping_
+                && num_queued_.load(std::memory_order_acquire) == 0) {
+                return;
+            }
+        }
+    }
+
+    void execute(std::size_t index, Task task) {
+        const std::size_t grain = task.job->grain();
+
+        while (task.last - task.first > grain) {
+            const std::size_t middle =
+                task.first + (task.last - task.first) / 2;
+
+            push(index, { task.job, middle, task.last });
+            task.last = middle;
+        }
+
+        if (!task.job->run(task.first, task.last)) {
+            return;
+        }
+
+        // wakes the thread waiting in parallel_for; taking the lock first
+        // means it cannot miss this between its check and its wait
+        {
+            std::lock_guard<std::mutex> lock{ sleep_mutex_ };
+        }
+
+        sleep_condition_.notify_all();
+    }
+
+    void stop() noexcept {
+        {
+            std::lock_guard<std::mutex> lock{ sleep_mutex_ };
+            is_stopping_ = true;
+        }
+
+        sleep_condition_.notify_all();
+
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    // the count goes up before the task is visible so that it never drops
+    // below zero; a worker that wakes early just looks again
+    void push(std::size_t index, const Task &task) {
+        {
+            std::lock_guard<std::mutex> lock{ sleep_mutex_ };
+            num_queued_.fetch_add(1, std::memory_order_release);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{ queues_[index]->mutex };
+            queues_[index]->tasks.push_back(task);
+        }
+
+        sleep_condition_.notify_one();
+    }
+
+    bool find_task(std::size_t index, Task &task) {
+        {
+            Queue &own = *queues_[index];
+            std::lock_guard<std::mutex> lock{ own.mutex };
+
+            if (!own.tasks.empty()) {
+                task = own.tasks.back();
+                own.tasks.pop_back();
+                num_queued_.fetch_sub(1, std::memory_order_acq_rel);
+
+                return true;
+            }
+        }
+
+        for (std::size_t i = 1; i < queues_.size(); ++i) {
+            Queue &victim = *queues_[(index + i) % queues_.size()];
+            std::lock_guard<std::mutex> lock{ victim.mutex };
+
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                num_queued_.fetch_sub(1, std::memory_order_acq_rel);
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> num_queued_{ 0 };
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_condition_;
+    bool is_stopping_ = false;
+};
+
+inline ThreadPool& default_thread_pool() {
+    static ThreadPool pool;
+
+    return pool;
+}
+
+// where and how finely a parallel operation runs. a grain of zero picks
+// one that gives every thread several pieces of work
+class Parallelism {
+public:
+    explicit Parallelism(std::size_t grain = 0) noexcept
+    : pool_{ nullptr }, grain_{ grain } { }
+
+    explicit Parallelism(ThreadPool &pool, std::size_t grain = 0) noexcept
+    : pool_{ std::addressof(pool) }, grain_{ grain } { }
+
+    ThreadPool& pool() const {
+        return pool_ ? *pool_ : default_thread_pool();
+    }
+
+    std::size_t grain(std::size_t count) const {
+        if (grain_ != 0) {
+            return grain_;
+        }
+
+        const std::size_t pieces = 8 * (pool().size() + 1);
+
+        return std::max(count / pieces, std::size_t{ 1 });
+    }
+
+private:
+    ThreadPool *pool_;
+    std::size_t grain_;
+};
+
+} // namespace ranges
+} // namespace umigv
+
+#endif
@@ -2,9 +2,11 @@
 #define UMIGV_RANGES_TRAITS_HPP
 
 #include <iterator>
+#include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace umigv {
 namespace ranges {
@@ -129,6 +131,19 @@ struct is_random_access_iterator<T, true>
 : true_type_if_t<std::is_base_of<std::random_access_iterator_tag,
                                  iterator_category_t<T>>::value> { };
 
+template <typename T, bool IsRandomAccess = is_random_access_iterator<T>::value>
+struct clamped_iterator_category {
+    using type = std::random_access_iterator_tag;
+};
+
+template <typename T>
+struct clamped_iterator_category<T, false> {
+    using type = iterator_category_t<T>;
+};
+
+template <typename T>
+using clamped_iterator_category_t = typename clamped_iterator_category<T>::type;
+
 template <typename T, typename = void>
 struct begin_result { };
 
@@ -162,6 +177,24 @@ struct remove_cvref {
 template <typename T>
 using remove_cvref_t = typename remove_cvref<T>::type;
 
+template <typename T>
+struct add_const_reference {
+    using type = const T;
+};
+
+template <typename T>
+struct add_const_reference<T&> {
+    using type = const T&;
+};
+
+template <typename T>
+struct add_const_reference<T&&> {
+    using type = const T&&;
+};
+
+template <typename T>
+using add_const_reference_t = typename add_const_reference<T>::type;
+
 template <typename T>
 struct decompose {
     using type = std::conditional_t<
@@ -266,6 +299,53 @@ template <class T, class... Ts>
 struct disjunction<T, Ts...>
 : std::conditional_t<static_cast<bool>(T::value), T, disjunction<Ts...>> { };
 
+template <typename T>
+struct is_vector_iterator
+: true_type_if_t<
+    !std::is_same<iterator_value_t<T>, bool>::value
+    && (std::is_same<
+            T, typename std::vector<iterator_value_t<T>>::iterator
+        >::value
+        || std::is_same<
+            T, typename std::vector<iterator_value_t<T>>::const_iterator
+        >::value)
+> { };
+
+template <typename T>
+struct is_character
+: true_type_if_t<std::is_same<T, char>::value
+                 || std::is_same<T, wchar_t>::value
+                 || std::is_same<T, char16_t>::value
+                 || std::is_same<T, char32_t>::value> { };
+
+template <typename T,
+          bool IsCharacter = is_character<iterator_value_t<T>>::value>
+struct is_string_iterator : std::false_type { };
+
+template <typename T>
+struct is_string_iterator<T, true>
+: true_type_if_t<
+    std::is_same<
+        T, typename std::basic_string<iterator_value_t<T>>::iterator
+    >::value
+    || std::is_same<
+        T, typename std::basic_string<iterator_value_t<T>>::const_iterator
+    >::value
+> { };
+
+// random access iterators whose elements are laid out next to each other in
+// memory, so that [first, first + n) can be read through &*first. C++14 has
+// no tag for these; pointers and the iterators of std::vector and
+// std::basic_string are recognized, and other iterator types may specialize
+// this trait
+template <typename T, bool IsRandomAccess = is_random_access_iterator<T>::value>
+struct is_contiguous_iterator : std::false_type { };
+
+template <typename T>
+struct is_contiguous_iterator<T, true>
+: disjunction<std::is_pointer<T>, is_vector_iterator<T>,
+              is_string_iterator<T>> { };
+
 } // namespace ranges
 } // namespace umigv
 
@@ -1,9 +1,15 @@
 #ifndef UMIGV_RANGES_ZIPPED_RANGE_HPP
 #define UMIGV_RANGES_ZIPPED_RANGE_HPP
 
+#include "detail/size_hint.hpp"
+#include "detail/zipped_range.hpp"
+
+#include "check_policy.hpp"
 #include "range_fwd.hpp"
+#include "size_hint.hpp"
 #include "traits.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
 #include <tuple>
@@ -13,29 +19,36 @@
 namespace umigv {
 namespace ranges {
 
-template <typename T, std::size_t ...Is>
+template <typename T, typename C, std::size_t ...Is>
 class ZippedRange;
 
 template <typename T, std::size_t ...Is>
 class ZippedRangeIterator {
+    using CursorT = detail::ZipCursor<T, std::index_sequence<Is...>>;
+    using IsRandomAccessT =
+        detail::is_random_access_zip<T, std::index_sequence<Is...>>;
+
 public:
-    friend ZippedRange<T, Is...>;
+    template <typename U, typename C, std::size_t ...Js>
+    friend class ZippedRange;
 
     using difference_type = std::ptrdiff_t;
-    using iterator_category = std::input_iterator_tag;
+    using iterator_category = std::conditional_t<
+        IsRandomAccessT::value,
+        std::random_access_iterator_tag,
+        std::input_iterator_tag
+    >;
     using pointer = void;
-    using reference =
-        std::tuple<iterator_reference_t<std::tuple_element_t<Is, T>>...>;
+    using reference = typename CursorT::reference;
     using value_type =
         std::tuple<iterator_value_t<std::tuple_element_t<Is, T>>...>;
 
     constexpr reference operator*() const {
-        return reference{ (*std::get<Is>(currents_))... };
+        return cursor_.dereference();
     }
 
     constexpr ZippedRangeIterator& operator++() {
-        using ExpanderT = int[];
-        (void) ExpanderT{ 0, (++std::get<Is>(currents_), 0)... };
+        cursor_.increment();
 
         return *this;
     }
@@ -48,11 +61,105 @@ public:
         return to_return;
     }
 
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    constexpr ZippedRangeIterator& operator--() {
+        cursor_.advance(-1);
+
+        return *this;
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    constexpr ZippedRangeIterator operator--(int) {
+        const auto to_return = *this;
+
+        --*this;
+
+        return to_return;
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    constexpr ZippedRangeIterator& operator+=(difference_type n) {
+        cursor_.advance(n);
+
+        return *this;
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    constexpr ZippedRangeIterator& operator-=(difference_type n) {
+        cursor_.advance(-n);
+
+        return *this;
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    constexpr reference operator[](difference_type n) const {
+        return *(*this + n);
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    friend constexpr ZippedRangeIterator operator+(ZippedRangeIterator iter,
+                                                   difference_type n) {
+        return iter += n;
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    friend constexpr ZippedRangeIterator operator+(difference_type n,
+                                                   ZippedRangeIterator iter) {
+        return iter += n;
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    friend constexpr ZippedRangeIterator operator-(ZippedRangeIterator iter,
+                                                   difference_type n) {
+        return iter -= n;
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    friend constexpr difference_type operator-(const ZippedRangeIterator &lhs,
+                                               const ZippedRangeIterator &rhs) {
+        return lhs.cursor_.index() - rhs.cursor_.index();
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    friend constexpr bool operator<(const ZippedRangeIterator &lhs,
+                                    const ZippedRangeIterator &rhs) {
+        return lhs.cursor_.index() < rhs.cursor_.index();
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    friend constexpr bool operator>(const ZippedRangeIterator &lhs,
+                                    const ZippedRangeIterator &rhs) {
+        return rhs < lhs;
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    friend constexpr bool operator<=(const ZippedRangeIterator &lhs,
+                                     const ZippedRangeIterator &rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<R::value, int> = 0>
+    friend constexpr bool operator>=(const ZippedRangeIterator &lhs,
+                                     const ZippedRangeIterator &rhs) {
+        return !(lhs < rhs);
+    }
+
     constexpr friend bool operator==(const ZippedRangeIterator &lhs,
                                      const ZippedRangeIterator &rhs) {
-        return variadic_or(
-            (std::get<Is>(lhs.currents_) == std::get<Is>(rhs.currents_))...
-        );
+        return lhs.cursor_.equal(rhs.cursor_);
     }
 
     constexpr friend bool operator!=(const ZippedRangeIterator &lhs,
@@ -60,30 +167,43 @@ public:
         return !(lhs == rhs);
     }
 
-private:
-    constexpr ZippedRangeIterator(const T &currents, const T &ends)
-    noexcept(std::is_nothrow_copy_constructible<T>::value)
-    : currents_{ currents }, ends_{ ends } { }
-
-    constexpr static bool variadic_or() {
-        return false;
+    template <typename J = T,
+              std::enable_if_t<
+                  !IsRandomAccessT::value
+                  && conjunction<detail::is_sized<
+                      std::tuple_element_t<Is, J>, std::tuple_element_t<Is, J>
+                  >...>::value,
+                  int
+              > = 0>
+    friend constexpr difference_type
+    sized_distance(const ZippedRangeIterator &first,
+                   const ZippedRangeIterator &last) {
+        return std::min({ static_cast<difference_type>(
+            detail::do_sized_distance(std::get<Is>(first.cursor_.currents()),
+                                      std::get<Is>(last.cursor_.currents()))
+        )... });
     }
 
-    template <typename ...Ts>
-    constexpr static bool variadic_or(bool value, Ts &&...rest) noexcept {
-        if (value) {
-            return true;
-        }
-
-        return variadic_or(std::forward<Ts>(rest)...);
+    template <typename R = IsRandomAccessT,
+              std::enable_if_t<!R::value, int> = 0>
+    friend constexpr SizeHint size_hint(const ZippedRangeIterator &first,
+                                        const ZippedRangeIterator &last) {
+        return detail::min_size_hint(
+            detail::do_size_hint(std::get<Is>(first.cursor_.currents()),
+                                 std::get<Is>(last.cursor_.currents()))...
+        );
     }
 
-    T currents_;
-    T ends_;
+private:
+    constexpr explicit ZippedRangeIterator(const CursorT &cursor)
+    noexcept(std::is_nothrow_copy_constructible<T>::value)
+    : cursor_{ cursor } { }
+
+    CursorT cursor_;
 };
 
-template <typename T, std::size_t ...Is>
-class ZippedRange : public Range<ZippedRange<T, Is...>> {
+template <typename T, typename C, std::size_t ...Is>
+class ZippedRange : public Range<ZippedRange<T, C, Is...>> {
 public:
     // static_assert(is_tuple<T>::value, "T must be a tuple of iterators");
     // static_assert(
@@ -93,44 +213,102 @@ public:
     // static_assert(tuple_size<T>::value == sizeof...(Is),
     //               "Is must be a sequence of indices corresponding to T's size");
 
+    using check_policy = typename RangeTraits<ZippedRange>::check_policy;
     using iterator = ZippedRangeIterator<T, Is...>;
     using difference_type = typename iterator::difference_type;
     using pointer = typename iterator::pointer;
     using reference = typename iterator::reference;
+    using sentinel = iterator;
     using value_type = typename iterator::value_type;
 
     constexpr ZippedRange(const T &begins, const T &ends)
-    noexcept(std::is_nothrow_copy_constructible<T>::value)
-    : begins_{ begins }, ends_{ ends } { }
+    : bounds_{ begins, ends } { }
 
     constexpr iterator begin() const
     noexcept(std::is_nothrow_copy_constructible<T>::value) {
-        return { begins_, ends_ };
+        return iterator{ bounds_.first() };
     }
 
     constexpr iterator end() const
     noexcept(std::is_nothrow_copy_constructible<T>::value) {
-        return { ends_, ends_ };
+        return iterator{ bounds_.last() };
+    }
+
+    constexpr sentinel end_sentinel() const
+    noexcept(std::is_nothrow_copy_constructible<T>::value) {
+        return end();
+    }
+
+    // every input of each half is cut at the same element, so the halves
+    // stay in lockstep; the halves are no longer than the shortest input
+    template <typename U = T,
+              std::enable_if_t<
+                  detail::is_random_access_zip<
+                      U, std::index_sequence<Is...>
+                  >::value,
+                  int
+              > = 0>
+    constexpr std::pair<ZippedRange, ZippedRange>
+    split_at(difference_type n) const {
+        if (check_policy::enabled && (n < 0 || n > bounds_.size())) {
+            check_policy::fail("ZippedRange::split_at");
+        }
+
+        const auto halves = bounds_.split_at(n);
+
+        return { ZippedRange{ halves.first }, ZippedRange{ halves.second } };
+    }
+
+    template <typename U = T,
+              std::enable_if_t<
+                  detail::is_random_access_zip<
+                      U, std::index_sequence<Is...>
+                  >::value,
+                  int
+              > = 0>
+    constexpr std::pair<ZippedRange, ZippedRange> split() const {
+        return split_at(bounds_.size() / 2);
     }
 
 private:
-    T begins_;
-    T ends_;
+    using BoundsT = detail::ZipBounds<T, std::index_sequence<Is...>>;
+
+    constexpr explicit ZippedRange(const BoundsT &bounds)
+    noexcept(std::is_nothrow_copy_constructible<BoundsT>::value)
+    : bounds_{ bounds } { }
+
+    BoundsT bounds_;
 };
 
-template <typename T, std::size_t ...Is>
-struct RangeTraits<ZippedRange<T, Is...>> {
+template <typename T, typename C, std::size_t ...Is>
+struct RangeTraits<ZippedRange<T, C, Is...>> {
+    using check_policy = C;
     using iterator = ZippedRangeIterator<T, Is...>;
     using difference_type = typename iterator::difference_type;
     using pointer = typename iterator::pointer;
     using reference = typename iterator::reference;
+    using sentinel = iterator;
     using value_type = typename iterator::value_type;
 };
 
 namespace detail {
 
-template <typename T, std::size_t ...Is>
-constexpr ZippedRange<remove_cvref_t<T>, Is...> zip(
+// zipped ranges check with the policy of the first range
+template <typename ...Rs>
+struct zip_check_policy {
+    using type = DefaultChecks;
+};
+
+template <typename R, typename ...Rs>
+struct zip_check_policy<R, Rs...> {
+    using type = range_check_policy_t<R>;
+};
+
+template <typename ...Rs>
+using zip_check_policy_t = typename zip_check_policy<Rs...>::type;
+
+template <typename C, typename T, std::size_t ...Is>
+constexpr ZippedRange<remove_cvref_t<T>, C, Is...> zip(
     T &&begins, T &&ends, std::index_sequence<Is...>
 ) noexcept(std::is_nothrow_copy_constructible<T>::value) {
     return { std::forward<T>(begins), std::forward<T>(ends) };
@@ -148,9 +326,11 @@ noexcept(conjunction<
 
     using TupleT = std::tuple<begin_result_t<Rs>...>;
 
-    return detail::zip(TupleT{ begin(std::forward<Rs>(ranges))... },
-                       TupleT{ end(std::forward<Rs>(ranges))... },
-                       std::index_sequence_for<Rs...>{ });
+    return detail::zip<detail::zip_check_policy_t<Rs...>>(
+        TupleT{ begin(std::forward<Rs>(ranges))... },
+        TupleT{ end(std::forward<Rs>(ranges))... },
+        std::index_sequence_for<Rs...>{ }
+    );
 }
 
 } // namespace ranges
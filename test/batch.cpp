@@ -0,0 +1,96 @@
+#include "ranges.hpp"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+template <typename R>
+std::vector<typename R::value_type> read_batches(const R &range,
+                                                 std::size_t capacity) {
+    std::vector<typename R::value_type> buffer(capacity);
+    std::vector<typename R::value_type> all;
+    auto reader = range.batches();
+    std::size_t count;
+
+    while ((count = reader.next_batch(buffer.data(), capacity)) != 0) {
+        EXPECT_LE(count, capacity);
+        all.insert(all.end(), buffer.cbegin(),
+                   buffer.cbegin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+    return all;
+}
+
+TEST(BatchTest, Counting) {
+    const auto range = umigv::ranges::range(0, 3, 1000);
+
+    EXPECT_EQ(read_batches(range, 7), range.collect<std::vector<int>>());
+}
+
+TEST(BatchTest, Mapped) {
+    const std::vector<int> v = umigv::ranges::range(1000).collect();
+    auto adapted = umigv::ranges::adapt(v);
+    const auto range = adapted.map([](int x) { return x * 3 + 1; });
+
+    EXPECT_EQ(read_batches(range, 64), range.collect<std::vector<int>>());
+}
+
+TEST(BatchTest, Filtered) {
+    const auto range = umigv::ranges::range(1000)
+        .filter([](int x) { return x % 3 == 0; });
+
+    const std::vector<int> expected = range.collect();
+
+    EXPECT_EQ(read_batches(range, 10), expected);
+    EXPECT_EQ(read_batches(range, 300), expected);
+    EXPECT_EQ(read_batches(range, 1), expected);
+}
+
+TEST(BatchTest, MappedOverFiltered) {
+    const auto range = umigv::ranges::range(600)
+        .filter([](int x) { return x % 7 != 0; })
+        .map([](int x) { return std::to_string(x); });
+
+    EXPECT_EQ(read_batches(range, 100),
+              range.collect<std::vector<std::string>>());
+}
+
+TEST(BatchTest, InputIterator) {
+    std::istringstream iss{ "1 2 3 4 5 6 7 8" };
+    auto adapted = umigv::ranges::adapt(std::istream_iterator<int>{ iss },
+                                        std::istream_iterator<int>{ });
+    auto reader = adapted.map([](int x) { return x * x; }).batches();
+
+    std::array<int, 3> buffer;
+
+    EXPECT_EQ(reader.next_batch(buffer), 3u);
+    EXPECT_EQ(buffer, (std::array<int, 3>{ { 1, 4, 9 } }));
+    EXPECT_EQ(reader.next_batch(buffer), 3u);
+    EXPECT_EQ(reader.next_batch(buffer), 2u);
+    EXPECT_EQ(buffer[1], 64);
+    EXPECT_EQ(reader.next_batch(buffer), 0u);
+}
+
+TEST(BatchTest, MutatingMapIsNotStaged) {
+    std::list<int> l{ 1, 2, 3 };
+    auto adapted = umigv::ranges::adapt(l);
+    const auto range = adapted.map([](int &x) { return x *= 2; });
+
+    EXPECT_EQ(read_batches(range, 2), (std::vector<int>{ 2, 4, 6 }));
+    EXPECT_EQ(l, (std::list<int>{ 2, 4, 6 }));
+}
+
+TEST(BatchTest, ByValueMapIsStaged) {
+    std::list<int> l{ 1, 2, 3 };
+    auto adapted = umigv::ranges::adapt(l);
+    const auto range = adapted.map([](int x) { return x * 2; });
+
+    EXPECT_EQ(read_batches(range, 2), (std::vector<int>{ 2, 4, 6 }));
+    EXPECT_EQ(l, (std::list<int>{ 1, 2, 3 }));
+}
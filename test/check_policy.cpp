@@ -0,0 +1,59 @@
+#define UMIGV_RANGES_CHECK_POLICY ::umigv::ranges::NoChecks
+
+#include "ranges.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(CheckPolicyTest, TranslationUnitDefault) {
+    static_assert(std::is_same<umigv::ranges::DefaultChecks,
+                               umigv::ranges::NoChecks>::value,
+                  "UMIGV_RANGES_CHECK_POLICY must select the default policy");
+
+    const auto short_range = umigv::ranges::range(4);
+    const auto long_range = umigv::ranges::range(8);
+
+    EXPECT_NO_THROW(short_range.begin() == long_range.begin());
+}
+
+TEST(CheckPolicyTest, PerRange) {
+    const auto short_range =
+        umigv::ranges::range<umigv::ranges::ThrowingChecks>(4);
+    const auto long_range =
+        umigv::ranges::range<umigv::ranges::ThrowingChecks>(8);
+
+    EXPECT_THROW(short_range.begin() == long_range.begin(), std::out_of_range);
+    EXPECT_THROW(*short_range.end(), std::out_of_range);
+}
+
+TEST(CheckPolicyTest, Propagation) {
+    constexpr std::array<int, 4> INPUT{ { 0, 1, 2, 3 } };
+    constexpr std::array<int, 2> OUTPUT{ { 0, 4 } };
+
+    const std::vector<int> v(INPUT.cbegin(), INPUT.cend());
+    const auto checked = umigv::ranges::adapt<umigv::ranges::ThrowingChecks>(v)
+        .filter([](int x) { return x % 2 == 0; })
+        .map([](int x) { return x * 2; });
+
+    static_assert(std::is_same<
+        decltype(checked)::check_policy, umigv::ranges::ThrowingChecks
+    >::value, "adaptors must inherit the policy of their source");
+
+    const std::vector<int> u = checked.collect();
+
+    EXPECT_TRUE(std::equal(u.cbegin(), u.cend(), OUTPUT.cbegin())
+                && u.size() == OUTPUT.size());
+    EXPECT_THROW(*checked.end(), std::out_of_range);
+}
+
+#ifndef NDEBUG
+TEST(CheckPolicyDeathTest, Asserting) {
+    const auto r = umigv::ranges::range<umigv::ranges::AssertingChecks>(4);
+
+    EXPECT_DEATH(*r.end(), "CountingRangeIterator");
+}
+#endif
@@ -2,6 +2,9 @@
 
 #include <algorithm>
 #include <array>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 
@@ -17,3 +20,157 @@ TEST(CollectTest, Basic) {
     EXPECT_TRUE(std::equal(sorted.cbegin(), sorted.cend(), OUTPUT.cbegin())
                 && u.size() == OUTPUT.size());
 }
+
+TEST(CollectTest, Filtered) {
+    std::vector<float> cloud;
+
+    for (int i = 0; i < 1000; ++i) {
+        cloud.push_back(static_cast<float>((i * 37) % 101) - 50.0f);
+    }
+
+    const auto is_close = [](float x) { return x > -10.0f && x < 10.0f; };
+
+    std::vector<float> expected;
+    std::copy_if(cloud.cbegin(), cloud.cend(), std::back_inserter(expected),
+                 is_close);
+
+    const auto filtered = umigv::ranges::adapt(cloud).filter(is_close);
+
+    const auto collected = filtered.collect<std::vector<float>>();
+    EXPECT_EQ(collected, expected);
+
+    const std::vector<float> converted = filtered.collect();
+    EXPECT_EQ(converted, expected);
+
+    const auto none = umigv::ranges::adapt(cloud)
+        .filter([](float x) { return x > 100.0f; })
+        .collect<std::vector<float>>();
+    EXPECT_TRUE(none.empty());
+}
+
+TEST(CollectTest, SparseFilterKeepsCapacitySmall) {
+    const auto sparse = umigv::ranges::range(1 << 24)
+        .filter([](int x) { return x % (1 << 22) == 0; });
+
+    const auto collected = sparse.collect<std::vector<int>>();
+
+    EXPECT_EQ(collected, (std::vector<int>{ 0, 1 << 22, 2 << 22, 3 << 22 }));
+    EXPECT_LE(collected.capacity(), 2 * collected.size());
+
+}
+
+TEST(CollectTest, SparseFilterKeepsCallerCapacity) {
+    const auto sparse = umigv::ranges::range(1 << 20)
+        .filter([](int x) { return x % (1 << 18) == 0; });
+
+    std::vector<int> frame;
+    frame.reserve(64);
+    sparse.collect_into(frame);
+
+    EXPECT_EQ(frame, (std::vector<int>{ 0, 1 << 18, 2 << 18, 3 << 18 }));
+    EXPECT_GE(frame.capacity(), 64u);
+
+    const int *const data = frame.data();
+    const std::size_t capacity = frame.capacity();
+
+    for (int i = 0; i < 4; ++i) {
+        sparse.collect_into(frame);
+
+        EXPECT_EQ(frame.size(), 4u);
+        EXPECT_EQ(frame.data(), data);
+        EXPECT_EQ(frame.capacity(), capacity);
+    }
+}
+
+TEST(CollectTest, IntoReusesCapacity) {
+    const std::vector<int> v{ 0, 1, 2, 3, 4, 5, 6, 7 };
+    const auto evens = umigv::ranges::adapt(v)
+        .filter([](int x) { return x % 2 == 0; });
+
+    std::vector<int> frame;
+    evens.collect_into(frame);
+    EXPECT_EQ(frame, (std::vector<int>{ 0, 2, 4, 6 }));
+
+    const int *const data = frame.data();
+    const std::size_t capacity = frame.capacity();
+
+    for (int i = 0; i < 4; ++i) {
+        evens.collect_into(frame);
+
+        EXPECT_EQ(frame, (std::vector<int>{ 0, 2, 4, 6 }));
+        EXPECT_EQ(frame.data(), data);
+        EXPECT_EQ(frame.capacity(), capacity);
+    }
+}
+
+TEST(CollectTest, Extend) {
+    std::vector<int> v{ -1 };
+    umigv::ranges::range(3).extend(v);
+    umigv::ranges::range(3).map([](int x) { return x * 10; }).extend(v);
+
+    EXPECT_EQ(v, (std::vector<int>{ -1, 0, 1, 2, 0, 10, 20 }));
+
+    std::unordered_set<int> u{ 5 };
+    umigv::ranges::range(3).extend(u);
+
+    EXPECT_EQ(u, (std::unordered_set<int>{ 0, 1, 2, 5 }));
+}
+
+TEST(CollectTest, Copy) {
+    std::array<int, 4> a{ };
+    const auto last = umigv::ranges::range(3)
+        .map([](int x) { return x + 1; })
+        .copy(a.begin());
+
+    EXPECT_EQ(last, a.begin() + 3);
+    EXPECT_EQ(a, (std::array<int, 4>{ { 1, 2, 3, 0 } }));
+
+    std::vector<int> v;
+    umigv::ranges::range(3).copy(std::back_inserter(v));
+
+    EXPECT_EQ(v, (std::vector<int>{ 0, 1, 2 }));
+}
+
+TEST(CollectTest, Contiguous) {
+    struct Point {
+        float x;
+        float y;
+        float z;
+    };
+
+    const std::vector<Point> frame{ { 0, 1, 2 }, { 3, 4, 5 }, { 6, 7, 8 } };
+    const auto adapted = umigv::ranges::adapt(frame).as_const();
+
+    static_assert(umigv::ranges::is_contiguous_iterator<
+        decltype(adapted)::iterator
+    >::value, "as_const must preserve contiguity");
+
+    const auto copied = adapted.collect<std::vector<Point>>();
+    ASSERT_EQ(copied.size(), frame.size());
+    EXPECT_EQ(copied[2].z, 8.0f);
+
+    std::vector<Point> reused{ { -1, -1, -1 } };
+    adapted.extend(reused);
+    ASSERT_EQ(reused.size(), 4u);
+    EXPECT_EQ(reused[1].x, 0.0f);
+
+    const std::vector<int> v{ 0, 1, 2, 3 };
+    const auto array = umigv::ranges::adapt(v).as_const()
+        .collect<std::array<int, 4>>();
+    EXPECT_EQ(array, (std::array<int, 4>{ { 0, 1, 2, 3 } }));
+
+    const std::vector<int> none;
+    const auto empty = umigv::ranges::adapt(none).collect<std::array<int, 0>>();
+    EXPECT_TRUE(empty.empty());
+
+    using TooShortT = std::array<int, 3>;
+    const auto checked = umigv::ranges::adapt<umigv::ranges::ThrowingChecks>(v);
+    EXPECT_THROW(checked.collect<TooShortT>(), std::out_of_range);
+
+    const auto unchecked = umigv::ranges::adapt<umigv::ranges::NoChecks>(v);
+    EXPECT_EQ(unchecked.collect<TooShortT>(),
+              (std::array<int, 3>{ { 0, 1, 2 } }));
+    using TooLongT = std::array<int, 6>;
+    EXPECT_EQ(unchecked.collect<TooLongT>(),
+              (TooLongT{ { 0, 1, 2, 3, 0, 0 } }));
+}
@@ -1,7 +1,11 @@
 #include "ranges.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -59,3 +63,24 @@ TEST(ConstIteratorTest, AsConst) {
     A::mut_copy_count = 0;
     A::const_copy_count = 0;
 }
+
+TEST(ConstIteratorTest, RandomAccess) {
+    const std::vector<int> INPUT{ 0, 2, 4, 6, 8 };
+
+    const auto adapted = umigv::ranges::adapt(INPUT).as_const();
+
+    using IteratorT = decltype(adapted.begin());
+
+    static_assert(std::is_same<
+        std::iterator_traits<IteratorT>::iterator_category,
+        std::random_access_iterator_tag
+    >::value, "as_const must preserve random access");
+    static_assert(std::is_same<
+        std::iterator_traits<IteratorT>::reference, const int&
+    >::value, "as_const must yield const references");
+
+    EXPECT_EQ(adapted.end() - adapted.begin(), 5);
+    EXPECT_EQ(adapted.begin()[3], 6);
+    EXPECT_EQ(std::lower_bound(adapted.begin(), adapted.end(), 5)
+              - adapted.begin(), 3);
+}
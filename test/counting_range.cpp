@@ -1,6 +1,11 @@
 #include "ranges.hpp"
 
+#include <algorithm>
+#include <array>
+#include <iterator>
 #include <limits>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -59,3 +64,105 @@ TEST(CountingRangeTest, Double) {
                            EpsilonEquals{ })
                 && u.size() == OUTPUT.size());
 }
+
+TEST(CountingRangeTest, UnevenStride) {
+    constexpr std::array<int, 3> OUTPUT{ { 0, 3, 6 } };
+
+    const std::vector<int> u = umigv::ranges::range(0, 3, 8).collect();
+
+    EXPECT_TRUE(std::equal(u.cbegin(), u.cend(), OUTPUT.cbegin())
+                && u.size() == OUTPUT.size());
+}
+
+TEST(CountingRangeTest, RandomAccess) {
+    const auto r = umigv::ranges::range(10, -2, -10);
+
+    using IteratorT = decltype(r.begin());
+
+    static_assert(std::is_same<
+        std::iterator_traits<IteratorT>::iterator_category,
+        std::random_access_iterator_tag
+    >::value, "CountingRange must be random access");
+
+    EXPECT_EQ(r.size(), 10);
+    EXPECT_EQ(std::distance(r.begin(), r.end()), 10);
+    EXPECT_EQ(r.begin()[4], 2);
+    EXPECT_EQ(*(r.end() - 1), -8);
+    EXPECT_THROW(r.begin() + 11, std::out_of_range);
+    EXPECT_THROW(*r.end(), std::out_of_range);
+}
+
+TEST(CountingRangeTest, Empty) {
+    EXPECT_EQ(umigv::ranges::range(5, 5).size(), 0);
+    EXPECT_EQ(umigv::ranges::range(5, 1).size(), 0);
+    EXPECT_EQ(umigv::ranges::range(0, -1, 4).size(), 0);
+    EXPECT_THROW(umigv::ranges::range(0, 0, 4), std::invalid_argument);
+}
+
+TEST(CountingRangeTest, StepNearLimit) {
+    constexpr int INT_MAXIMUM = std::numeric_limits<int>::max();
+    constexpr int INT_MINIMUM = std::numeric_limits<int>::min();
+    constexpr unsigned UNSIGNED_MAXIMUM = std::numeric_limits<unsigned>::max();
+
+    const auto thirds = umigv::ranges::range(0, 3, INT_MAXIMUM);
+    EXPECT_EQ(thirds.size(), 715827883u);
+    EXPECT_EQ(*(thirds.end() - 1), INT_MAXIMUM - 1);
+
+    EXPECT_EQ(umigv::ranges::range(0u, 3u, UNSIGNED_MAXIMUM).size(),
+              1431655765u);
+    EXPECT_EQ(umigv::ranges::range(0, INT_MAXIMUM, 3).size(), 1u);
+    EXPECT_EQ(umigv::ranges::range(0, INT_MAXIMUM, INT_MAXIMUM).size(), 1u);
+    EXPECT_EQ(umigv::ranges::range(0u, UNSIGNED_MAXIMUM, 3u).size(), 1u);
+    EXPECT_EQ(umigv::ranges::range(-1, INT_MINIMUM, -3).size(), 1u);
+    EXPECT_EQ(umigv::ranges::range(INT_MAXIMUM, INT_MINIMUM, -1).size(), 1u);
+
+    const auto wide = umigv::ranges::range(INT_MINIMUM, INT_MAXIMUM, INT_MAXIMUM)
+        .collect<std::vector<int>>();
+    EXPECT_EQ(wide, (std::vector<int>{ INT_MINIMUM, -1, INT_MAXIMUM - 1 }));
+}
+
+TEST(CountingRangeTest, FullWidth) {
+    constexpr int INT_MAXIMUM = std::numeric_limits<int>::max();
+    constexpr int INT_MINIMUM = std::numeric_limits<int>::min();
+
+    const auto ascending = umigv::ranges::range(INT_MINIMUM, INT_MAXIMUM);
+    EXPECT_EQ(ascending.size(), 0xffffffffu);
+    EXPECT_EQ(*ascending.begin(), INT_MINIMUM);
+    EXPECT_EQ(*(ascending.end() - 1), INT_MAXIMUM - 1);
+
+    const auto descending = umigv::ranges::range(INT_MAXIMUM, -1, INT_MINIMUM);
+    EXPECT_EQ(descending.size(), 0xffffffffu);
+    EXPECT_EQ(*(descending.end() - 1), INT_MINIMUM + 1);
+
+    const auto bytes = umigv::ranges::range<unsigned char>(0, 255)
+        .collect<std::vector<unsigned char>>();
+    EXPECT_EQ(bytes.size(), 255u);
+    EXPECT_EQ(bytes.back(), 254);
+}
+
+TEST(CountingRangeTest, FloatDoesNotDrift) {
+    const auto r = umigv::ranges::range(0.0f, 0.1f, 10000.0f);
+
+    EXPECT_EQ(r.size(), 100000);
+    EXPECT_FLOAT_EQ(r.begin()[99999], 99999 * 0.1f);
+}
+
+TEST(CountingRangeTest, SplitAt) {
+    const auto halves = umigv::ranges::range(0.0, 0.1, 1.0).split_at(3);
+
+    const std::vector<double> whole =
+        umigv::ranges::range(0.0, 0.1, 1.0).collect();
+    std::vector<double> joined = halves.first.collect();
+    const std::vector<double> second = halves.second.collect();
+    joined.insert(joined.end(), second.cbegin(), second.cend());
+
+    EXPECT_EQ(halves.first.size(), 3u);
+    EXPECT_EQ(halves.second.size(), 7u);
+    EXPECT_EQ(joined, whole);
+
+    const auto quarters = halves.second.split();
+
+    EXPECT_EQ(quarters.first.size(), 3u);
+    EXPECT_EQ(*quarters.second.begin(), whole[6]);
+    EXPECT_THROW(halves.first.split_at(4), std::out_of_range);
+}
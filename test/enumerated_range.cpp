@@ -2,8 +2,11 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <iterator>
 #include <sstream>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -44,3 +47,55 @@ TEST(EnumeratedRangeTest, IstreambufIterator) {
     ASSERT_TRUE(std::equal(OUTPUT.cbegin(), OUTPUT.cend(), v.cbegin())
                 && OUTPUT.size() == v.size());
 }
+
+TEST(EnumeratedRangeTest, RandomAccess) {
+    const std::vector<char> v{ 'a', 'b', 'c', 'd', 'e' };
+
+    auto adapted = umigv::ranges::adapt(v);
+    const auto enumerated = adapted.enumerate();
+
+    using IteratorT = decltype(enumerated.begin());
+
+    static_assert(std::is_same<
+        std::iterator_traits<IteratorT>::iterator_category,
+        std::random_access_iterator_tag
+    >::value, "enumerating a vector must preserve random access");
+    static_assert(std::is_same<
+        std::iterator_traits<IteratorT>::reference,
+        std::pair<std::size_t, const char&>
+    >::value, "enumerated elements must be returned by value");
+
+    const auto first = enumerated.begin();
+    const auto last = enumerated.end();
+
+    EXPECT_EQ(last - first, 5);
+    EXPECT_EQ(first[3], (std::pair<std::size_t, const char&>{ 3, v[3] }));
+    EXPECT_EQ((*(last - 1)).first, 4u);
+    EXPECT_EQ((*(first + 2)).second, 'c');
+
+    auto current = last;
+    --current;
+
+    EXPECT_EQ((*current).first, 4u);
+    EXPECT_EQ(&(*current).second, &v[4]);
+
+    auto before_first = first;
+    EXPECT_THROW(--before_first, std::out_of_range);
+    EXPECT_THROW(first - 1, std::out_of_range);
+    EXPECT_THROW(last + 1, std::out_of_range);
+    EXPECT_EQ((*(last - 5)).first, 0u);
+}
+
+TEST(EnumeratedRangeTest, SplitKeepsIndices) {
+    const std::vector<char> v{ 'a', 'b', 'c', 'd', 'e' };
+    const auto halves = umigv::ranges::enumerate(v).split_at(2);
+
+    const auto first = halves.second.begin();
+
+    EXPECT_EQ(halves.first.size(), 2u);
+    EXPECT_EQ(halves.second.size(), 3u);
+    EXPECT_EQ((*first).first, 2u);
+    EXPECT_EQ((*first).second, 'c');
+    EXPECT_EQ((*(halves.second.end() - 1)).first, 4u);
+    EXPECT_EQ((*halves.second.split().second.begin()).first, 3u);
+}
@@ -1,6 +1,10 @@
 #include "ranges.hpp"
 
 #include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -125,3 +129,222 @@ TEST(FilteredRangeTest, ApplyOverload) {
                 && tester.invoke_count == 3
                 && tester.apply_count == 0);
 }
+
+TEST(FilteredRangeTest, StatelessPredicateTakesNoSpace) {
+    const std::vector<int> v{ 0, 1, 2, 3 };
+
+    const auto filtered = umigv::ranges::adapt(v)
+        .filter([](int x) { return x % 2 == 0; });
+
+    using VectorIteratorT = std::vector<int>::const_iterator;
+
+    using CacheT = umigv::ranges::detail::FirstMatchCache<VectorIteratorT>;
+
+    static_assert(sizeof(filtered) == sizeof(VectorIteratorT) + sizeof(CacheT),
+                  "a stateless predicate must not grow the range beyond "
+                  "its iterators and the cached begin");
+    static_assert(sizeof(filtered.begin()) == 2 * sizeof(VectorIteratorT),
+                  "a stateless predicate must not grow the iterator");
+
+    auto first = filtered.begin();
+    first = filtered.end();
+
+    EXPECT_TRUE(first == filtered.end());
+}
+
+TEST(FilteredRangeTest, BeginIsCached) {
+    const std::vector<int> v{ 1, 3, 5, 7, 8, 9, 10 };
+    int invoke_count = 0;
+
+    const auto filtered = umigv::ranges::adapt(v)
+        .filter([&invoke_count](int x) {
+            ++invoke_count;
+
+            return x % 2 == 0;
+        });
+
+    EXPECT_EQ(*filtered.begin(), 8);
+    EXPECT_EQ(invoke_count, 5);
+
+    EXPECT_EQ(*filtered.begin(), 8);
+    EXPECT_EQ(*filtered.cbegin(), 8);
+    EXPECT_EQ(invoke_count, 5);
+
+    const std::vector<int> u = filtered.collect();
+
+    EXPECT_EQ(u, (std::vector<int>{ 8, 10 }));
+    EXPECT_EQ(invoke_count, 7);
+}
+
+TEST(FilteredRangeTest, ConcurrentBegin) {
+    std::vector<int> v(1000, 1);
+    v.push_back(2);
+    v.push_back(4);
+
+    const auto filtered = umigv::ranges::adapt(v).filter([](int x) {
+        return x % 2 == 0;
+    });
+
+    std::vector<int> firsts(4);
+    std::vector<std::thread> threads;
+
+    for (int &first : firsts) {
+        threads.emplace_back([&filtered, &first] {
+            first = *filtered.begin();
+        });
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(firsts, (std::vector<int>(4, 2)));
+    EXPECT_EQ(filtered.collect<std::vector<int>>(), (std::vector<int>{ 2, 4 }));
+}
+
+TEST(FilteredRangeTest, MappedValuesComputedOnce) {
+    const std::vector<int> v{ 0, 1, 2, 3, 4, 5, 6, 7 };
+    int map_count = 0;
+
+    const auto filtered = umigv::ranges::adapt(v)
+        .map([&map_count](int x) {
+            ++map_count;
+
+            return x * 3;
+        })
+        .filter([](const int &x) { return x % 2 == 0; });
+
+    static_assert(std::is_same<decltype(*filtered.begin()), const int&>::value,
+                  "the cached value must be handed back without a copy");
+
+    const std::vector<int> u = filtered.collect();
+
+    EXPECT_EQ(u, (std::vector<int>{ 0, 6, 12, 18 }));
+    EXPECT_EQ(map_count, 8);
+
+    map_count = 0;
+
+    EXPECT_EQ(*filtered.begin(), 0);
+    EXPECT_EQ(map_count, 1);
+}
+
+TEST(FilteredRangeTest, MappedStringsAreMoved) {
+    const std::vector<int> v{ 1, 22, 333 };
+
+    const auto filtered = umigv::ranges::adapt(v)
+        .map([](int x) { return std::to_string(x); })
+        .filter([](const std::string &s) { return s.size() > 1; });
+
+    static_assert(std::is_same<
+        decltype(*filtered.begin()), std::string
+    >::value, "values that are not trivially copyable must not be cached");
+
+    EXPECT_EQ(filtered.collect<std::vector<std::string>>(),
+              (std::vector<std::string>{ "22", "333" }));
+}
+
+TEST(FilteredRangeTest, SplitBySourcePosition) {
+    const std::vector<int> v{ 1, 3, 5, 7, 2, 4, 6, 8 };
+    auto range = umigv::ranges::adapt(v).filter([](int x) {
+        return x % 2 == 0;
+    });
+
+    const auto halves = range.split();
+    std::vector<int> evens;
+
+    std::thread worker{ [&evens, second = halves.second] {
+        evens = second.collect<std::vector<int>>();
+    } };
+    worker.join();
+
+    EXPECT_EQ(halves.first.begin(), halves.first.end());
+    EXPECT_EQ(evens, (std::vector<int>{ 2, 4, 6, 8 }));
+}
+
+TEST(FilteredRangeTest, SplitAfterBegin) {
+    const std::vector<int> v{ 1, 3, 5, 7, 2, 4, 6, 8 };
+    const auto range = umigv::ranges::adapt(v).filter([](int x) {
+        return x % 2 == 0;
+    });
+
+    const auto before = range.split_at(4);
+
+    EXPECT_EQ(*range.begin(), 2);
+
+    const auto after = range.split_at(4);
+    const auto whole = range.split_at(8);
+
+    EXPECT_EQ(before.first.begin(), before.first.end());
+    EXPECT_EQ(after.first.begin(), after.first.end());
+    EXPECT_EQ(after.second.collect<std::vector<int>>(),
+              (std::vector<int>{ 2, 4, 6, 8 }));
+    EXPECT_EQ(whole.first.collect<std::vector<int>>(),
+              (std::vector<int>{ 2, 4, 6, 8 }));
+    EXPECT_EQ(whole.second.begin(), whole.second.end());
+}
+
+TEST(FilteredRangeTest, ConsecutiveFiltersFuse) {
+    const std::vector<std::pair<int, int>> v{
+        { 0, 0 }, { 2, 3 }, { 1, 1 }, { 4, 4 }, { 6, 5 }
+    };
+
+    int num_second_calls = 0;
+    const auto is_equal = [](int x, int y) { return x == y; };
+    const auto is_even = [&num_second_calls](const std::pair<int, int> &p) {
+        ++num_second_calls;
+
+        return p.first % 2 == 0;
+    };
+
+    const auto once = umigv::ranges::adapt(v).filter(is_equal);
+    const auto fused = once.filter(is_even);
+    const auto nested = umigv::ranges::filter(once, is_even);
+
+    static_assert(sizeof(fused.begin()) < sizeof(nested.begin()),
+                  "fused filters must be a single iterator layer");
+
+    const std::vector<std::pair<int, int>> collected = fused.collect();
+
+    EXPECT_EQ(collected, (std::vector<std::pair<int, int>>{ { 0, 0 },
+                                                             { 4, 4 } }));
+    EXPECT_EQ(num_second_calls, 3);
+
+    const std::vector<std::pair<int, int>> nested_collected =
+        nested.collect();
+
+    EXPECT_EQ(nested_collected, collected);
+}
+
+TEST(FilteredRangeTest, AsConstPropagatesExceptions) {
+    const std::vector<int> v{ 0, 1, 2, 3 };
+    auto adapted = umigv::ranges::adapt(v);
+    const auto filtered = adapted.filter([](int x) -> bool {
+        if (x == 0) {
+            throw std::runtime_error{ "zero" };
+        }
+
+        return x % 2 == 0;
+    });
+
+    static_assert(!noexcept(filtered.as_const()),
+                  "as_const must not be noexcept when begin can throw");
+    EXPECT_THROW(filtered.as_const(), std::runtime_error);
+    static_assert(noexcept(adapted.as_const()),
+                  "as_const must stay noexcept over a vector");
+}
+
+TEST(FilteredRangeTest, ResetAfterSourceChanges) {
+    std::vector<int> v{ 1, 2, 3, 4 };
+    auto filtered = umigv::ranges::adapt(v)
+        .filter([](int x) { return x % 2 == 0; });
+
+    EXPECT_EQ(*filtered.begin(), 2);
+
+    v[0] = 0;
+    EXPECT_EQ(*filtered.begin(), 2);
+
+    filtered.reset();
+    EXPECT_EQ(*filtered.begin(), 0);
+    EXPECT_EQ(filtered.collect<std::vector<int>>(),
+              (std::vector<int>{ 0, 2, 4 }));
+}
@@ -2,9 +2,13 @@
 
 #include <algorithm>
 #include <array>
+#include <forward_list>
 #include <iterator>
+#include <list>
 #include <set>
+#include <stdexcept>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -83,3 +87,147 @@ TEST(MappedRangeTest, ApplyOverload) {
                 && v.size() == OUTPUT.size()
                 && adder.apply_count == 0 && adder.invoke_count == 3);
 }
+
+TEST(MappedRangeTest, RandomAccess) {
+    constexpr std::array<int, 8> INPUT{ { 0, 1, 2, 3, 4, 5, 6, 7 } };
+
+    const std::vector<int> v(INPUT.cbegin(), INPUT.cend());
+    const auto mapped = umigv::ranges::adapt(v)
+        .map([](int x) { return x * 3; });
+
+    using IteratorT = decltype(mapped.begin());
+
+    static_assert(std::is_same<
+        std::iterator_traits<IteratorT>::iterator_category,
+        std::random_access_iterator_tag
+    >::value, "mapping a vector must preserve random access");
+
+    const auto first = mapped.begin();
+    const auto last = mapped.end();
+
+    EXPECT_EQ(last - first, 8);
+    EXPECT_EQ(first[5], 15);
+    EXPECT_EQ(*(last - 1), 21);
+    EXPECT_TRUE(first < last);
+
+    const auto found = std::lower_bound(first, last, 12);
+
+    EXPECT_EQ(found - first, 4);
+    EXPECT_THROW(first + 9, std::out_of_range);
+    EXPECT_THROW(first - 1, std::out_of_range);
+    EXPECT_THROW(first + -1, std::out_of_range);
+    EXPECT_THROW(last - 9, std::out_of_range);
+    EXPECT_EQ(*(last - 8), 0);
+
+    auto copy = first;
+    EXPECT_THROW(--copy, std::out_of_range);
+}
+
+TEST(MappedRangeTest, BidirectionalChecksStart) {
+    const std::list<int> l{ 0, 1, 2 };
+    const std::forward_list<int> fl{ 0, 1, 2 };
+    const auto mapped = umigv::ranges::adapt(l).map([](int x) { return x; });
+    const auto forward =
+        umigv::ranges::adapt(fl).map([](int x) { return x; });
+
+    using ListIteratorT = std::list<int>::const_iterator;
+    using ForwardListIteratorT = std::forward_list<int>::const_iterator;
+
+    static_assert(sizeof(forward.begin()) == 2 * sizeof(ForwardListIteratorT),
+                  "an iterator that cannot move backwards must not track "
+                  "its start");
+    static_assert(sizeof(mapped.begin()) == 3 * sizeof(ListIteratorT),
+                  "a bidirectional iterator must track its start");
+
+    auto last = mapped.end();
+    EXPECT_EQ(*--last, 2);
+
+    auto first = mapped.begin();
+    EXPECT_THROW(--first, std::out_of_range);
+}
+
+TEST(MappedRangeTest, InputCategory) {
+    std::istringstream iss{ "foo" };
+
+    const auto mapped = umigv::ranges::adapt(std::istreambuf_iterator<char>{ iss },
+                                             std::istreambuf_iterator<char>{ })
+        .map([](char c) { return c; });
+
+    using IteratorT = decltype(mapped.begin());
+
+    static_assert(std::is_same<
+        std::iterator_traits<IteratorT>::iterator_category,
+        std::input_iterator_tag
+    >::value, "mapping an input range must stay an input range");
+}
+
+TEST(MappedRangeTest, StatelessCallableTakesNoSpace) {
+    const std::vector<int> v{ 0, 1, 2, 3 };
+    const auto plus_one = [](int x) { return x + 1; };
+    const auto is_even = [](int x) { return x % 2 == 0; };
+
+    const auto mapped = umigv::ranges::adapt(v).map(plus_one);
+    auto filtered = umigv::ranges::adapt<umigv::ranges::NoChecks>(v)
+        .map(plus_one)
+        .filter(is_even);
+    const auto unchecked = filtered.map([](int x) { return x * 2; });
+
+    using VectorIteratorT = std::vector<int>::const_iterator;
+    using UncheckedMappedT = decltype(
+        umigv::ranges::adapt<umigv::ranges::NoChecks>(v).map(plus_one).begin()
+    );
+    using CacheT = umigv::ranges::detail::DereferenceCache<
+        UncheckedMappedT, std::decay_t<decltype(is_even)>
+    >;
+
+    static_assert(sizeof(mapped) == 2 * sizeof(VectorIteratorT),
+                  "a stateless callable must not grow the range");
+    static_assert(sizeof(mapped.begin()) == 3 * sizeof(VectorIteratorT),
+                  "a stateless callable must not grow the iterator beyond "
+                  "its position and checked bounds");
+    static_assert(sizeof(UncheckedMappedT) == sizeof(VectorIteratorT),
+                  "an unchecked mapped iterator must be a bare iterator");
+    static_assert(sizeof(filtered.begin())
+                      == 2 * sizeof(VectorIteratorT) + sizeof(CacheT),
+                  "a stateless predicate must add only the cached value");
+    static_assert(sizeof(unchecked.begin()) == sizeof(filtered.begin()),
+                  "a stateless callable must not grow a nested iterator");
+
+    const std::vector<int> collected = unchecked.collect();
+
+    EXPECT_EQ(collected, (std::vector<int>{ 4, 8 }));
+}
+
+TEST(MappedRangeTest, Split) {
+    const std::vector<int> v{ 1, 2, 3, 4 };
+    const auto halves =
+        umigv::ranges::adapt(v).map([](int x) { return x * 10; }).split();
+
+    EXPECT_EQ(halves.first.collect<std::vector<int>>(),
+              (std::vector<int>{ 10, 20 }));
+    EXPECT_EQ(halves.second.collect<std::vector<int>>(),
+              (std::vector<int>{ 30, 40 }));
+}
+
+TEST(MappedRangeTest, ConsecutiveMapsFuse) {
+    const std::vector<std::pair<int, int>> v{ { 0, 1 }, { 2, 3 }, { 4, 5 } };
+    const auto add = [](int x, int y) { return x + y; };
+    const auto twice = [](int x) { return x * 2; };
+
+    const auto once = umigv::ranges::adapt(v).map(add);
+    const auto fused = once.map(twice).map(twice);
+    const auto nested =
+        umigv::ranges::map(umigv::ranges::map(once, twice), twice);
+
+    static_assert(sizeof(fused.begin()) == sizeof(once.begin()),
+                  "fused maps must be a single iterator layer");
+    static_assert(sizeof(fused.begin()) < sizeof(nested.begin()),
+                  "fused maps must be smaller than nested maps");
+
+    const std::vector<int> fused_values = fused.collect();
+    const std::vector<int> nested_values = nested.collect();
+
+    EXPECT_EQ(fused_values, (std::vector<int>{ 4, 20, 36 }));
+    EXPECT_EQ(fused_values, nested_values);
+    EXPECT_EQ(fused.size(), 3u);
+}
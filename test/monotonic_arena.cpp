@@ -0,0 +1,71 @@
+#include "ranges.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(MonotonicArenaTest, Alignment) {
+    umigv::ranges::MonotonicArena arena{ 64 };
+
+    arena.allocate(1, 1);
+    void *const aligned = arena.allocate(8, 32);
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 32, 0u);
+
+    void *const large = arena.allocate(1000, 16);
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % 16, 0u);
+    EXPECT_GE(arena.capacity(), 1000u);
+}
+
+TEST(MonotonicArenaTest, ResetKeepsLargestBlock) {
+    umigv::ranges::MonotonicArena arena{ 16 };
+
+    for (int i = 0; i < 8; ++i) {
+        arena.allocate(16, 1);
+    }
+
+    const std::size_t capacity = arena.capacity();
+    arena.reset();
+
+    EXPECT_LT(arena.capacity(), capacity);
+
+    const std::size_t kept = arena.capacity();
+    void *const first = arena.allocate(kept, 1);
+
+    EXPECT_NE(first, nullptr);
+    EXPECT_EQ(arena.capacity(), kept);
+}
+
+TEST(MonotonicArenaTest, Collect) {
+    using AllocatorT = umigv::ranges::ArenaAllocator<int>;
+    using VectorT = std::vector<int, AllocatorT>;
+
+    umigv::ranges::MonotonicArena arena;
+    std::size_t capacity = 0;
+
+    for (int frame = 0; frame < 4; ++frame) {
+        arena.reset();
+
+        const VectorT evens = umigv::ranges::range(100)
+            .filter([](int x) { return x % 2 == 0; })
+            .collect<VectorT>(AllocatorT{ arena });
+        const VectorT squares = umigv::ranges::range(10)
+            .map([](int x) { return x * x; })
+            .collect<VectorT>(AllocatorT{ arena });
+
+        ASSERT_EQ(evens.size(), 50u);
+        EXPECT_EQ(evens[49], 98);
+        ASSERT_EQ(squares.size(), 10u);
+        EXPECT_EQ(squares[9], 81);
+        EXPECT_EQ(evens.get_allocator(), AllocatorT{ arena });
+
+        if (frame == 1) {
+            capacity = arena.capacity();
+        } else if (frame > 1) {
+            EXPECT_EQ(arena.capacity(), capacity);
+        }
+    }
+}
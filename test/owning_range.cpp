@@ -0,0 +1,142 @@
+#include "ranges.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+std::vector<int> make_vector() {
+    return { 0, 1, 2, 3, 4, 5 };
+}
+
+std::vector<std::string> make_words() {
+    return { std::string(32, 'a'), std::string(32, 'b'),
+             std::string(32, 'c') };
+}
+
+} // namespace
+
+TEST(OwningRangeTest, KeepsTemporaryAlive) {
+    const auto squares = umigv::ranges::adapt(make_vector())
+        .filter([](int x) { return x % 2 == 0; })
+        .map([](int x) { return x * x; });
+
+    const std::vector<int> first = squares.collect();
+    const std::vector<int> second = squares.collect();
+
+    EXPECT_EQ(first, (std::vector<int>{ 0, 4, 16 }));
+    EXPECT_EQ(second, first);
+}
+
+TEST(OwningRangeTest, LvaluesAreNotOwned) {
+    std::vector<int> v = make_vector();
+    auto adapted = umigv::ranges::adapt(v);
+
+    static_assert(std::is_same<
+        decltype(adapted),
+        umigv::ranges::RangeAdapter<std::vector<int>::iterator>
+    >::value, "lvalue containers must be adapted in place");
+
+    *adapted.begin() = 42;
+    EXPECT_EQ(v.front(), 42);
+
+    static_assert(std::is_same<
+        decltype(umigv::ranges::adapt(umigv::ranges::range(4))),
+        umigv::ranges::RangeAdapter<
+            umigv::ranges::CountingRangeIterator<int>
+        >
+    >::value, "views must not be owned");
+}
+
+TEST(OwningRangeTest, RandomAccess) {
+    const auto owned =
+        umigv::ranges::adapt<umigv::ranges::NoChecks>(make_vector());
+
+    static_assert(std::is_same<
+        decltype(owned)::check_policy, umigv::ranges::NoChecks
+    >::value, "the check policy must be kept");
+    static_assert(umigv::ranges::is_contiguous_iterator<
+        decltype(owned)::iterator
+    >::value, "an owned vector must stay contiguous");
+
+    EXPECT_EQ(owned.size(), 6u);
+    EXPECT_EQ(owned.begin()[3], 3);
+    EXPECT_EQ(owned.sum(), 15);
+}
+
+TEST(OwningRangeTest, IntoIterMoves) {
+    std::vector<std::string> words = make_words();
+    const std::vector<const char*> data{
+        words[0].data(), words[1].data(), words[2].data()
+    };
+
+    const auto moved = umigv::ranges::into_iter(std::move(words));
+
+    static_assert(std::is_same<
+        decltype(moved)::reference, std::string&&
+    >::value, "into_iter must yield rvalues");
+
+    const std::vector<std::string> collected = moved.collect();
+
+    ASSERT_EQ(collected.size(), 3u);
+    EXPECT_EQ(collected[0], std::string(32, 'a'));
+
+    for (std::size_t i = 0; i < collected.size(); ++i) {
+        EXPECT_EQ(collected[i].data(), data[i]);
+    }
+}
+
+TEST(OwningRangeTest, IntoIterMap) {
+    const auto lengths = umigv::ranges::into_iter(make_words())
+        .map([](std::string &&word) {
+            std::string taken = std::move(word);
+
+            return taken.size();
+        });
+
+    std::size_t total = 0;
+
+    for (const std::size_t length : lengths) {
+        total += length;
+    }
+
+    EXPECT_EQ(total, 96u);
+
+    std::vector<std::unique_ptr<int>> pointers;
+    pointers.push_back(std::make_unique<int>(1));
+    pointers.push_back(std::make_unique<int>(2));
+
+    const std::vector<std::unique_ptr<int>> taken =
+        umigv::ranges::into_iter(std::move(pointers)).collect();
+
+    ASSERT_EQ(taken.size(), 2u);
+    EXPECT_EQ(*taken[1], 2);
+}
+
+TEST(OwningRangeTest, Split) {
+    const auto halves = umigv::ranges::adapt(make_vector()).split();
+
+    EXPECT_EQ(halves.first.collect<std::vector<int>>(),
+              (std::vector<int>{ 0, 1, 2 }));
+    EXPECT_EQ(halves.second.collect<std::vector<int>>(),
+              (std::vector<int>{ 3, 4, 5 }));
+
+    const auto quarters = halves.second.split_at(1);
+
+    EXPECT_EQ(quarters.first.size(), 1u);
+    EXPECT_EQ(quarters.second.sum(), 9);
+}
+
+TEST(OwningRangeTest, IntoIterFilterByValue) {
+    const std::vector<std::string> kept = umigv::ranges::into_iter(make_words())
+        .filter([](std::string word) { return word[0] != 'b'; })
+        .collect();
+
+    EXPECT_EQ(kept, (std::vector<std::string>{ std::string(32, 'a'),
+                                               std::string(32, 'c') }));
+}
@@ -0,0 +1,98 @@
+#include "ranges.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(ParMappedRangeTest, KeepsOrder) {
+    const std::vector<int> u = umigv::ranges::range(200)
+        .par_map([](int x) {
+            // later elements finish first
+            std::this_thread::sleep_for(std::chrono::microseconds(200 - x));
+
+            return x * 2;
+        }, 4, 8)
+        .collect();
+
+    ASSERT_EQ(u.size(), 200u);
+
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_EQ(u[static_cast<std::size_t>(i)], i * 2);
+    }
+}
+
+TEST(ParMappedRangeTest, InputIterator) {
+    std::istringstream iss{ "3 1 4 1 5 9 2 6" };
+
+    const std::vector<std::string> u = umigv::ranges::adapt(
+        std::istream_iterator<int>{ iss }, std::istream_iterator<int>{ }
+    ).par_map([](int x) { return std::string(static_cast<std::size_t>(x),
+                                             '*'); }, 3).collect();
+
+    EXPECT_EQ(u, (std::vector<std::string>{ "***", "*", "****", "*",
+                                            "*****", "*********", "**",
+                                            "******" }));
+}
+
+TEST(ParMappedRangeTest, PostIncrement) {
+    const auto range =
+        umigv::ranges::range(3).par_map([](int x) { return x * 10; }, 2);
+    auto first = range.begin();
+
+    EXPECT_EQ(*first++, 0);
+    EXPECT_EQ(*first++, 10);
+    EXPECT_EQ(*first, 20);
+}
+
+TEST(ParMappedRangeTest, Empty) {
+    const std::vector<int> v;
+    const auto range = umigv::ranges::par_map(v, [](int x) { return x; });
+
+    EXPECT_EQ(range.begin(), range.end());
+}
+
+TEST(ParMappedRangeTest, Exception) {
+    const auto range = umigv::ranges::range(100).par_map([](int x) {
+        if (x == 50) {
+            throw std::runtime_error{ "fifty" };
+        }
+
+        return x;
+    }, 4, 16);
+
+    int count = 0;
+
+    EXPECT_THROW(range.for_each([&count](int) { ++count; }),
+                 std::runtime_error);
+    EXPECT_EQ(count, 50);
+}
+
+TEST(ParMappedRangeTest, ExceptionOnFirstElement) {
+    const auto range = umigv::ranges::range(100).par_map([](int x) -> int {
+        if (x == 0) {
+            throw std::runtime_error{ "zero" };
+        }
+
+        return x;
+    }, 4, 16);
+
+    EXPECT_THROW(range.begin(), std::runtime_error);
+    EXPECT_THROW(range.cbegin(), std::runtime_error);
+    EXPECT_THROW(range.collect<std::vector<int>>(), std::runtime_error);
+}
+
+TEST(ParMappedRangeTest, StopsEarly) {
+    const auto range =
+        umigv::ranges::range(1 << 30).par_map([](int x) { return -x; }, 2);
+    auto first = range.begin();
+
+    EXPECT_EQ(*first, 0);
+    EXPECT_EQ(*++first, -1);
+}
@@ -0,0 +1,119 @@
+#include "ranges.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(PrefetchedRangeTest, Basic) {
+    const std::vector<int> v{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+    const std::vector<std::string> u = umigv::ranges::adapt(v)
+        .map([](int x) { return std::to_string(x * x); })
+        .prefetch(3)
+        .filter([](const std::string &s) { return s.size() == 2; })
+        .collect();
+
+    EXPECT_EQ(u, (std::vector<std::string>{ "16", "25", "36", "49", "64",
+                                            "81" }));
+}
+
+TEST(PrefetchedRangeTest, RunsUpstreamOnAnotherThread) {
+    const auto caller = std::this_thread::get_id();
+    std::atomic<int> num_foreign{ 0 };
+
+    const int sum = umigv::ranges::range(100)
+        .map([caller, &num_foreign](int x) {
+            if (std::this_thread::get_id() != caller) {
+                ++num_foreign;
+            }
+
+            return x;
+        })
+        .prefetch(8)
+        .fold(0, [](int acc, int x) { return acc + x; });
+
+    EXPECT_EQ(sum, 4950);
+    EXPECT_EQ(num_foreign.load(), 100);
+}
+
+TEST(PrefetchedRangeTest, Empty) {
+    const std::vector<int> v;
+    const auto range = umigv::ranges::prefetch(v, 4);
+
+    EXPECT_EQ(range.begin(), range.end());
+}
+
+TEST(PrefetchedRangeTest, StopsEarly) {
+    const auto range = umigv::ranges::range(1 << 30).prefetch(16);
+    auto first = range.begin();
+
+    EXPECT_EQ(*first, 0);
+    EXPECT_EQ(*++first, 1);
+}
+
+TEST(PrefetchedRangeTest, PostIncrement) {
+    const auto range = umigv::ranges::range(3).prefetch(1);
+    auto first = range.begin();
+
+    EXPECT_EQ(*first++, 0);
+    EXPECT_EQ(*first++, 1);
+    EXPECT_EQ(*first, 2);
+}
+
+TEST(PrefetchedRangeTest, SlowProducerAndConsumer) {
+    const auto range = umigv::ranges::range(20).map([](int x) {
+        if (x < 10) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 2 });
+        }
+
+        return x;
+    }).prefetch(1);
+
+    int expected = 0;
+
+    for (const int x : range) {
+        if (x >= 10) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{ 2 });
+        }
+
+        EXPECT_EQ(x, expected++);
+    }
+
+    EXPECT_EQ(expected, 20);
+}
+
+TEST(PrefetchedRangeTest, Exception) {
+    const auto range = umigv::ranges::range(10).map([](int x) {
+        if (x == 5) {
+            throw std::runtime_error{ "five" };
+        }
+
+        return x;
+    }).prefetch(2);
+
+    std::vector<int> seen;
+
+    EXPECT_THROW(range.for_each([&seen](int x) { seen.push_back(x); }),
+                 std::runtime_error);
+    EXPECT_EQ(seen, (std::vector<int>{ 0, 1, 2, 3, 4 }));
+    EXPECT_THROW(umigv::ranges::prefetch(seen, 0), std::invalid_argument);
+}
+
+TEST(PrefetchedRangeTest, ExceptionOnFirstElement) {
+    const auto range = umigv::ranges::range(10).map([](int x) -> int {
+        if (x == 0) {
+            throw std::runtime_error{ "zero" };
+        }
+
+        return x;
+    }).prefetch(2);
+
+    EXPECT_THROW(range.begin(), std::runtime_error);
+    EXPECT_THROW(range.cbegin(), std::runtime_error);
+    EXPECT_THROW(range.collect<std::vector<int>>(), std::runtime_error);
+}
@@ -0,0 +1,270 @@
+#include "ranges.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(RangeTest, ForEach) {
+    const std::vector<int> v{ 0, 1, 2, 3, 4, 5, 6, 7 };
+    int map_count = 0;
+    int filter_count = 0;
+    std::vector<int> u;
+
+    umigv::ranges::adapt(v)
+        .map([&map_count](int x) {
+            ++map_count;
+
+            return x * 2;
+        })
+        .filter([&filter_count](int x) {
+            ++filter_count;
+
+            return x % 4 == 0;
+        })
+        .map([](int x) { return x + 1; })
+        .for_each([&u](int x) { u.push_back(x); });
+
+    EXPECT_EQ(u, (std::vector<int>{ 1, 5, 9, 13 }));
+    EXPECT_EQ(map_count, 8);
+    EXPECT_EQ(filter_count, 8);
+}
+
+TEST(RangeTest, Fold) {
+    const auto sum = umigv::ranges::range(1, 101)
+        .fold(0, [](int acc, int x) { return acc + x; });
+
+    EXPECT_EQ(sum, 5050);
+
+    const std::vector<int> v{ 3, 1, 4, 1, 5 };
+    const auto weighted = umigv::ranges::adapt(v)
+        .enumerate()
+        .fold(std::size_t{ 0 }, [](std::size_t acc, const auto &pair) {
+            return acc + pair.first * static_cast<std::size_t>(pair.second);
+        });
+
+    EXPECT_EQ(weighted, 0u + 1u + 8u + 3u + 20u);
+}
+
+TEST(RangeTest, TryFold) {
+    using umigv::ranges::ControlFlow;
+
+    const std::vector<int> v{ 2, 4, 6, 7, 8, 10 };
+    int visited = 0;
+
+    const auto flow = umigv::ranges::adapt(v)
+        .map([](int x) { return x * 10; })
+        .try_fold(0, [&visited](int acc, int x) {
+            ++visited;
+
+            if (x % 20 != 0) {
+                return ControlFlow<int>::stop(acc);
+            }
+
+            return ControlFlow<int>::proceed(acc + x);
+        });
+
+    EXPECT_TRUE(flow.is_stop());
+    EXPECT_EQ(flow.value(), 120);
+    EXPECT_EQ(visited, 4);
+
+    const auto finished = umigv::ranges::range(5)
+        .try_fold(0, [](int acc, int x) {
+            return ControlFlow<int>::proceed(acc + x);
+        });
+
+    EXPECT_FALSE(finished.is_stop());
+    EXPECT_EQ(finished.value(), 10);
+}
+
+TEST(RangeTest, FoldZipped) {
+    const std::vector<int> v{ 1, 2, 3 };
+    const std::array<int, 3> a{ { 4, 5, 6 } };
+
+    const auto dot = umigv::ranges::adapt(v).zip(a)
+        .fold(0, [](int acc, const auto &pair) {
+            return acc + std::get<0>(pair) * std::get<1>(pair);
+        });
+
+    EXPECT_EQ(dot, 32);
+}
+
+TEST(RangeTest, ParallelForEach) {
+    std::vector<int> v(10000, 0);
+
+    umigv::ranges::range(v.size())
+        .par_for_each([&v](std::size_t i) { v[i] = static_cast<int>(i) * 2; },
+                      umigv::ranges::Parallelism{ 100 });
+
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        ASSERT_EQ(v[i], static_cast<int>(i) * 2);
+    }
+}
+
+TEST(RangeTest, ParallelReduce) {
+    umigv::ranges::ThreadPool pool{ 3 };
+
+    const auto sum = umigv::ranges::range(std::int64_t{ 1 },
+                                          std::int64_t{ 100001 })
+        .map([](std::int64_t x) { return x * x; })
+        .par_reduce(std::int64_t{ 0 },
+                    [](std::int64_t acc, std::int64_t x) { return acc + x; },
+                    umigv::ranges::Parallelism{ pool, 1000 });
+
+    EXPECT_EQ(sum, std::int64_t{ 333338333350000 });
+
+    const std::vector<std::string> words{ "a", "b", "c", "d", "e", "f" };
+    const auto joined = umigv::ranges::adapt(words)
+        .par_reduce(std::string{ }, [](std::string acc, const std::string &s) {
+            return acc + s;
+        }, umigv::ranges::Parallelism{ pool, 1 });
+
+    EXPECT_EQ(joined, "abcdef");
+}
+
+TEST(RangeTest, ParallelCollect) {
+    const std::vector<int> a(5000, 3);
+    const std::vector<int> b = umigv::ranges::range(5000).collect();
+
+    const std::vector<int> v = umigv::ranges::adapt(a).zip(b)
+        .map([](int x, int y) { return x * y; })
+        .par_collect();
+
+    ASSERT_EQ(v.size(), 5000u);
+
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        ASSERT_EQ(v[i], 3 * static_cast<int>(i));
+    }
+}
+
+TEST(RangeTest, Sum) {
+    std::vector<float> v;
+
+    for (int i = 0; i < 1001; ++i) {
+        v.push_back(0.1f * static_cast<float>(i % 17));
+    }
+
+    auto adapted = umigv::ranges::adapt(v);
+    const float contiguous = adapted.sum();
+    const float mapped = adapted.map([](float x) { return x; }).sum();
+    const float filtered = adapted.filter([](float) { return true; }).sum();
+
+    // the lanes make the result independent of how the elements arrive
+    EXPECT_EQ(contiguous, mapped);
+    EXPECT_EQ(contiguous, filtered);
+    EXPECT_NEAR(contiguous, 799.3f, 1e-2f);
+
+    EXPECT_EQ(umigv::ranges::range(1, 101).sum(), 5050);
+    EXPECT_EQ(umigv::ranges::range(0).sum(), 0);
+
+    const std::vector<std::string> words{ "a", "b", "c" };
+    EXPECT_EQ(umigv::ranges::adapt(words).sum(), "abc");
+}
+
+TEST(RangeTest, MinMax) {
+    const std::vector<double> v{ 3.5, -1.0, 8.25, 0.0, 7.0, -4.5, 2.0, 1.0,
+                                 6.0, 5.0 };
+    auto adapted = umigv::ranges::adapt(v);
+
+    EXPECT_EQ(adapted.min().value(), -4.5);
+    EXPECT_EQ(adapted.max().value(), 8.25);
+    EXPECT_EQ(adapted.minmax().value(), std::make_pair(-4.5, 8.25));
+
+    const auto evens = umigv::ranges::range(1000)
+        .filter([](int x) { return x % 2 == 0; });
+
+    EXPECT_EQ(evens.min().value(), 0);
+    EXPECT_EQ(evens.max().value(), 998);
+    EXPECT_FALSE(umigv::ranges::range(0).min().has_value());
+    EXPECT_FALSE(umigv::ranges::range(0).minmax().has_value());
+
+    const std::vector<std::string> words{ "pear", "apple", "quince" };
+    const auto bounds = umigv::ranges::adapt(words).minmax().value();
+
+    EXPECT_EQ(bounds.first, "apple");
+    EXPECT_EQ(bounds.second, "quince");
+}
+
+TEST(RangeTest, Count) {
+    EXPECT_EQ(umigv::ranges::range(10).count(), 10u);
+    EXPECT_EQ(umigv::ranges::range(1000)
+                  .filter([](int x) { return x % 3 == 0; })
+                  .count(),
+              334u);
+}
+
+TEST(RangeTest, Find) {
+    const std::string bytes = "occupancy grid: ....#..";
+    auto adapted = umigv::ranges::adapt(bytes);
+
+    EXPECT_EQ(adapted.find('#').value(), '#');
+    EXPECT_EQ(adapted.position('#').value(), 20u);
+    EXPECT_FALSE(adapted.position('!').has_value());
+    EXPECT_FALSE(adapted.find('!').has_value());
+
+    static_assert(umigv::ranges::is_contiguous_iterator<
+        std::string::const_iterator
+    >::value, "string iterators must be recognized as contiguous");
+
+    const std::vector<std::uint8_t> cells{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                           0, 0, 0, 0, 0, 0, 0, 0, 1, 0 };
+
+    EXPECT_EQ(umigv::ranges::adapt(cells).position(std::uint8_t{ 1 }).value(),
+              18u);
+
+    std::vector<int> v = umigv::ranges::range(100).collect();
+    v[77] = -1;
+    auto ints = umigv::ranges::adapt(v);
+
+    EXPECT_EQ(ints.position(-1).value(), 77u);
+    EXPECT_EQ(ints.position(99).value(), 99u);
+    EXPECT_FALSE(ints.position(100).has_value());
+
+    const std::vector<float> zeros{ 1.0f, -0.0f, 0.0f };
+    const float zero = umigv::ranges::adapt(zeros).find(0.0f).value();
+
+    EXPECT_EQ(zero, 0.0f);
+    EXPECT_TRUE(std::signbit(zero));
+
+    int num_tested = 0;
+    const auto first_large = umigv::ranges::range(1000)
+        .map([](int x) { return x * x; })
+        .find([&num_tested](int x) {
+            ++num_tested;
+
+            return x > 50;
+        });
+
+    EXPECT_EQ(first_large.value(), 64);
+    EXPECT_EQ(num_tested, 9);
+    EXPECT_EQ(umigv::ranges::range(10)
+                  .filter([](int x) { return x % 2 == 1; })
+                  .position([](int x) { return x > 4; })
+                  .value(),
+              2u);
+}
+
+TEST(RangeTest, AnyAll) {
+    const auto range = umigv::ranges::range(10);
+
+    EXPECT_TRUE(range.any([](int x) { return x == 9; }));
+    EXPECT_FALSE(range.any([](int x) { return x > 9; }));
+    EXPECT_TRUE(range.all([](int x) { return x < 10; }));
+    EXPECT_FALSE(range.all([](int x) { return x < 9; }));
+    EXPECT_TRUE(range.none([](int x) { return x < 0; }));
+    EXPECT_TRUE(umigv::ranges::range(0).all([](int) { return false; }));
+
+    int num_tested = 0;
+    range.any([&num_tested](int x) {
+        ++num_tested;
+
+        return x == 3;
+    });
+
+    EXPECT_EQ(num_tested, 4);
+}
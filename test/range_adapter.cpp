@@ -5,6 +5,7 @@
 #include <iterator>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -40,3 +41,14 @@ TEST(RangeAdapterTest, InitializerList) {
     EXPECT_TRUE(std::equal(v.cbegin(), v.cend(), OUTPUT.cbegin())
                 && v.size() == OUTPUT.size());
 }
+
+TEST(RangeAdapterTest, Split) {
+    const std::vector<int> v{ 0, 1, 2, 3, 4 };
+    const auto halves = umigv::ranges::adapt(v).split();
+
+    EXPECT_EQ(halves.first.collect<std::vector<int>>(),
+              (std::vector<int>{ 0, 1 }));
+    EXPECT_EQ(halves.second.collect<std::vector<int>>(),
+              (std::vector<int>{ 2, 3, 4 }));
+    EXPECT_THROW(umigv::ranges::adapt(v).split_at(6), std::out_of_range);
+}
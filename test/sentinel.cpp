@@ -0,0 +1,59 @@
+#include "ranges.hpp"
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(SentinelTest, Pipeline) {
+    constexpr std::array<int, 8> INPUT{ { 0, 1, 2, 3, 4, 5, 6, 7 } };
+    constexpr std::array<int, 4> OUTPUT{ { 1, 5, 9, 13 } };
+
+    const std::vector<int> v(INPUT.cbegin(), INPUT.cend());
+    const auto pipeline = umigv::ranges::adapt(v)
+        .map([](int x) { return x * 2; })
+        .filter([](int x) { return x % 4 == 0; })
+        .map([](int x) { return x + 1; });
+
+    std::vector<int> u;
+
+    for (auto first = pipeline.begin(); first != pipeline.end_sentinel();
+         ++first) {
+        u.push_back(*first);
+    }
+
+    EXPECT_TRUE(std::equal(u.cbegin(), u.cend(), OUTPUT.cbegin())
+                && u.size() == OUTPUT.size());
+}
+
+TEST(SentinelTest, CountingAndEnumerated) {
+    auto counting = umigv::ranges::range(2, 5);
+    const auto enumerated = counting.enumerate();
+
+    std::size_t count = 0;
+
+    for (auto first = enumerated.begin(); first != enumerated.end_sentinel();
+         ++first) {
+        EXPECT_EQ((*first).first, count);
+        EXPECT_EQ((*first).second, static_cast<int>(count) + 2);
+        ++count;
+    }
+
+    EXPECT_EQ(count, 3);
+    EXPECT_TRUE(counting.end() == counting.end_sentinel());
+}
+
+TEST(SentinelTest, UncheckedIteratorsDropBounds) {
+    using BaseT = std::vector<int>::const_iterator;
+
+    const std::vector<int> v{ 0, 1, 2 };
+    const auto checked = umigv::ranges::adapt<umigv::ranges::ThrowingChecks>(v)
+        .map([](int x) { return x; });
+    const auto unchecked = umigv::ranges::adapt<umigv::ranges::NoChecks>(v)
+        .map([](int x) { return x; });
+
+    EXPECT_EQ(sizeof(checked.end_sentinel()), sizeof(BaseT));
+    EXPECT_LT(sizeof(unchecked.begin()), sizeof(checked.begin()));
+    EXPECT_EQ(sizeof(umigv::ranges::range<umigv::ranges::NoChecks>(8).begin()),
+              sizeof(int) * 2 + sizeof(std::ptrdiff_t));
+}
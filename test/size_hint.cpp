@@ -0,0 +1,145 @@
+#include "ranges.hpp"
+
+#include <array>
+#include <cstddef>
+#include <list>
+#include <sstream>
+#include <iterator>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+class ReserveRecorder : public std::vector<int> {
+public:
+    ReserveRecorder() = default;
+
+    template <typename I>
+    ReserveRecorder(I first, I last) : std::vector<int>(first, last) { }
+
+    void reserve(std::size_t n) {
+        ++reserve_count;
+        std::vector<int>::reserve(n);
+    }
+
+    int reserve_count = 0;
+};
+
+class SinglePassIterator {
+public:
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::input_iterator_tag;
+    using pointer = const int*;
+    using reference = const int&;
+    using value_type = int;
+
+    explicit SinglePassIterator(std::vector<int>::const_iterator current)
+    : current_{ current } { }
+
+    reference operator*() const {
+        return *current_;
+    }
+
+    SinglePassIterator& operator++() {
+        ++current_;
+
+        return *this;
+    }
+
+    SinglePassIterator operator++(int) {
+        const auto to_return = *this;
+
+        ++*this;
+
+        return to_return;
+    }
+
+    friend bool operator==(const SinglePassIterator &lhs,
+                           const SinglePassIterator &rhs) {
+        return lhs.current_ == rhs.current_;
+    }
+
+    friend bool operator!=(const SinglePassIterator &lhs,
+                           const SinglePassIterator &rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend difference_type sized_distance(const SinglePassIterator &first,
+                                          const SinglePassIterator &last) {
+        return last.current_ - first.current_;
+    }
+
+private:
+    std::vector<int>::const_iterator current_;
+};
+
+} // namespace
+
+TEST(SizeHintTest, Sized) {
+    const std::vector<int> v{ 0, 1, 2, 3, 4, 5, 6, 7 };
+    const std::array<int, 5> a{ { 0, 1, 2, 3, 4 } };
+
+    auto adapted = umigv::ranges::adapt(v);
+
+    EXPECT_EQ(adapted.size(), 8u);
+    EXPECT_EQ(adapted.map([](int x) { return x * 2; }).size(), 8u);
+    EXPECT_EQ(adapted.enumerate().size(), 8u);
+    EXPECT_EQ(adapted.zip(a).size(), 5u);
+    EXPECT_EQ(umigv::ranges::range(0, 3, 10).size(), 4u);
+
+    auto enumerated = adapted.enumerate();
+    const auto hint = enumerated.map([](const auto &pair) {
+        return pair.second;
+    }).size_hint();
+
+    EXPECT_TRUE(hint.is_exact());
+    EXPECT_EQ(hint.lower(), 8u);
+}
+
+TEST(SizeHintTest, Filtered) {
+    const std::vector<int> v{ 1, 3, 4, 5, 6 };
+
+    const auto hint = umigv::ranges::adapt(v)
+        .filter([](int x) { return x % 2 == 0; })
+        .size_hint();
+
+    EXPECT_FALSE(hint.is_exact());
+    EXPECT_EQ(hint.lower(), 1u);
+    ASSERT_TRUE(hint.upper().has_value());
+    EXPECT_EQ(hint.upper().value(), 3u);
+
+    const auto empty = umigv::ranges::adapt(v)
+        .filter([](int x) { return x > 10; })
+        .size_hint();
+
+    EXPECT_EQ(empty.lower(), 0u);
+    EXPECT_EQ(empty.upper().value(), 0u);
+}
+
+TEST(SizeHintTest, Unknown) {
+    std::istringstream iss{ "foo" };
+
+    const auto hint = umigv::ranges::adapt(
+        std::istreambuf_iterator<char>{ iss }, std::istreambuf_iterator<char>{ }
+    ).size_hint();
+
+    EXPECT_EQ(hint.lower(), 0u);
+    EXPECT_FALSE(hint.upper().has_value());
+}
+
+TEST(SizeHintTest, CollectReservesOnce) {
+    const std::vector<int> v{ 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    const ReserveRecorder u = umigv::ranges::adapt(
+        SinglePassIterator{ v.cbegin() }, SinglePassIterator{ v.cend() }
+    ).enumerate()
+        .map([](const auto &pair) {
+            return static_cast<int>(pair.first) * pair.second;
+        })
+        .collect();
+
+    EXPECT_EQ(u.reserve_count, 1);
+    EXPECT_EQ(u.capacity(), 8u);
+    EXPECT_EQ(u, (std::vector<int>{ 0, 1, 4, 9, 16, 25, 36, 49 }));
+}
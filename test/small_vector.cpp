@@ -0,0 +1,135 @@
+#include "ranges.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+// counts live instances and throws from a copy once the countdown runs out
+struct Counted {
+    static int num_alive;
+    static int num_copies_left;
+
+    explicit Counted(int x) : value{ x } {
+        ++num_alive;
+    }
+
+    Counted(const Counted &other) : value{ other.value } {
+        if (num_copies_left-- == 0) {
+            throw std::runtime_error{ "Counted::Counted" };
+        }
+
+        ++num_alive;
+    }
+
+    ~Counted() {
+        --num_alive;
+    }
+
+    int value;
+};
+
+int Counted::num_alive = 0;
+int Counted::num_copies_left = -1;
+
+} // namespace
+
+TEST(SmallVectorTest, Basic) {
+    umigv::ranges::SmallVector<std::string, 2> v{ "b" };
+
+    v.insert(v.begin(), "a");
+    EXPECT_TRUE(v.is_inline());
+
+    v.push_back("c");
+    v.push_back(v.front());
+    EXPECT_FALSE(v.is_inline());
+
+    EXPECT_EQ(v, (umigv::ranges::SmallVector<std::string, 2>{
+        "a", "b", "c", "a"
+    }));
+
+    const std::string *const data = v.data();
+    auto moved = std::move(v);
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_TRUE(v.empty());
+
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+}
+
+TEST(SmallVectorTest, Collect) {
+    using VectorT = umigv::ranges::SmallVector<int, 4>;
+
+    const VectorT few = umigv::ranges::range(4).collect();
+    EXPECT_TRUE(few.is_inline());
+    EXPECT_EQ(few, (VectorT{ 0, 1, 2, 3 }));
+
+    const auto many = umigv::ranges::range(100)
+        .filter([](int x) { return x % 10 == 0; })
+        .collect<VectorT>();
+    EXPECT_FALSE(many.is_inline());
+    EXPECT_EQ(many.size(), 10u);
+    EXPECT_EQ(many.back(), 90);
+}
+
+TEST(SmallVectorTest, MoveOnly) {
+    umigv::ranges::SmallVector<std::unique_ptr<int>, 1> v;
+
+    for (int i = 0; i < 5; ++i) {
+        v.emplace_back(std::make_unique<int>(i));
+    }
+
+    ASSERT_EQ(v.size(), 5u);
+    EXPECT_EQ(*v[4], 4);
+
+    v.pop_back();
+    EXPECT_EQ(v.size(), 4u);
+}
+
+TEST(SmallVectorTest, ConstructorCleansUp) {
+    using VectorT = umigv::ranges::SmallVector<Counted, 2>;
+
+    {
+        VectorT source;
+
+        for (int i = 0; i < 4; ++i) {
+            source.emplace_back(i);
+        }
+
+        const int num_source = Counted::num_alive;
+
+        Counted::num_copies_left = 3;
+        EXPECT_THROW(VectorT{ source }, std::runtime_error);
+        EXPECT_EQ(Counted::num_alive, num_source);
+        Counted::num_copies_left = -1;
+    }
+
+    EXPECT_EQ(Counted::num_alive, 0);
+}
+
+TEST(SmallVectorTest, FailedGrowthLeavesVectorIntact) {
+    using VectorT = umigv::ranges::SmallVector<Counted, 2>;
+
+    {
+        VectorT v;
+        v.emplace_back(1);
+        v.emplace_back(2);
+
+        Counted::num_copies_left = 1;
+        EXPECT_THROW(v.push_back(Counted{ 3 }), std::runtime_error);
+        Counted::num_copies_left = -1;
+
+        ASSERT_EQ(v.size(), 2u);
+        EXPECT_TRUE(v.is_inline());
+        EXPECT_EQ(v[0].value, 1);
+        EXPECT_EQ(v[1].value, 2);
+        EXPECT_EQ(Counted::num_alive, 2);
+    }
+
+    EXPECT_EQ(Counted::num_alive, 0);
+}
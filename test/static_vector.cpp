@@ -0,0 +1,112 @@
+#include "ranges.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+// counts live instances and throws from a copy once the countdown runs out
+struct Counted {
+    static int num_alive;
+    static int num_copies_left;
+
+    explicit Counted(int x) : value{ x } {
+        ++num_alive;
+    }
+
+    Counted(const Counted &other) : value{ other.value } {
+        if (num_copies_left-- == 0) {
+            throw std::runtime_error{ "Counted::Counted" };
+        }
+
+        ++num_alive;
+    }
+
+    ~Counted() {
+        --num_alive;
+    }
+
+    int value;
+};
+
+int Counted::num_alive = 0;
+int Counted::num_copies_left = -1;
+
+} // namespace
+
+TEST(StaticVectorTest, Basic) {
+    umigv::ranges::StaticVector<std::string, 4> v{ "b", "c" };
+
+    v.insert(v.begin(), "a");
+    v.push_back("d");
+
+    EXPECT_EQ(v.size(), 4u);
+    EXPECT_EQ(v.front(), "a");
+    EXPECT_EQ(v.back(), "d");
+    EXPECT_EQ(v[2], "c");
+
+    auto moved = std::move(v);
+    EXPECT_EQ(moved, (umigv::ranges::StaticVector<std::string, 4>{
+        "a", "b", "c", "d"
+    }));
+
+    moved.pop_back();
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+}
+
+TEST(StaticVectorTest, Collect) {
+    using VectorT = umigv::ranges::StaticVector<int, 8>;
+
+    const VectorT squares = umigv::ranges::range(8)
+        .map([](int x) { return x * x; })
+        .collect();
+    EXPECT_EQ(squares, (VectorT{ 0, 1, 4, 9, 16, 25, 36, 49 }));
+
+    const auto evens = umigv::ranges::range(10)
+        .filter([](int x) { return x % 2 == 0; })
+        .collect<VectorT>();
+    EXPECT_EQ(evens, (VectorT{ 0, 2, 4, 6, 8 }));
+
+    VectorT reused;
+    umigv::ranges::range(3).collect_into(reused);
+    EXPECT_EQ(reused, (VectorT{ 0, 1, 2 }));
+}
+
+TEST(StaticVectorTest, Overflow) {
+    using VectorT =
+        umigv::ranges::StaticVector<int, 4, umigv::ranges::ThrowingChecks>;
+
+    VectorT v{ 0, 1, 2, 3 };
+    EXPECT_THROW(v.push_back(4), std::out_of_range);
+    EXPECT_EQ(v.size(), 4u);
+
+    const auto r = umigv::ranges::range(5);
+    EXPECT_THROW(r.collect<VectorT>(), std::out_of_range);
+}
+
+TEST(StaticVectorTest, ConstructorCleansUp) {
+    using VectorT =
+        umigv::ranges::StaticVector<Counted, 4, umigv::ranges::ThrowingChecks>;
+
+    {
+        const std::vector<Counted> source(5, Counted{ 0 });
+        const int num_source = Counted::num_alive;
+
+        EXPECT_THROW(VectorT(source.cbegin(), source.cend()),
+                     std::out_of_range);
+        EXPECT_EQ(Counted::num_alive, num_source);
+
+        Counted::num_copies_left = 2;
+        EXPECT_THROW(VectorT(source.cbegin(), source.cbegin() + 4),
+                     std::runtime_error);
+        EXPECT_EQ(Counted::num_alive, num_source);
+        Counted::num_copies_left = -1;
+    }
+
+    EXPECT_EQ(Counted::num_alive, 0);
+}
@@ -0,0 +1,68 @@
+#include "ranges.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(ThreadPoolTest, CoversEveryIndexOnce) {
+    umigv::ranges::ThreadPool pool{ 4 };
+
+    constexpr std::size_t COUNT = 100000;
+    std::vector<std::atomic<int>> visits(COUNT);
+    std::atomic<std::size_t> max_piece{ 0 };
+
+    pool.parallel_for(COUNT, 64, [&](std::size_t first, std::size_t last) {
+        std::size_t seen = max_piece.load();
+
+        while (last - first > seen
+               && !max_piece.compare_exchange_weak(seen, last - first)) { }
+
+        for (std::size_t i = first; i < last; ++i) {
+            ++visits[i];
+        }
+    });
+
+    for (const auto &visit : visits) {
+        ASSERT_EQ(visit.load(), 1);
+    }
+
+    EXPECT_LE(max_piece.load(), 64u);
+}
+
+TEST(ThreadPoolTest, Nested) {
+    umigv::ranges::ThreadPool pool{ 2 };
+    std::atomic<std::size_t> total{ 0 };
+
+    pool.parallel_for(8, 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            pool.parallel_for(100, 10, [&](std::size_t lower,
+                                           std::size_t upper) {
+                total += upper - lower;
+            });
+        }
+    });
+
+    EXPECT_EQ(total.load(), 800u);
+}
+
+TEST(ThreadPoolTest, Exception) {
+    umigv::ranges::ThreadPool pool{ 3 };
+
+    EXPECT_THROW(pool.parallel_for(1000, 10, [](std::size_t first,
+                                                std::size_t) {
+        if (first >= 500) {
+            throw std::runtime_error{ "ThreadPoolTest" };
+        }
+    }), std::runtime_error);
+
+    std::atomic<std::size_t> total{ 0 };
+
+    pool.parallel_for(1000, 10, [&](std::size_t first, std::size_t last) {
+        total += last - first;
+    });
+
+    EXPECT_EQ(total.load(), 1000u);
+}
@@ -1,8 +1,13 @@
 #include "ranges.hpp"
 
 #include <algorithm>
+#include <array>
+#include <iterator>
 #include <set>
 #include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -87,3 +92,67 @@ TEST(ZippedRange, Set) {
     EXPECT_TRUE(std::equal(s.cbegin(), s.cend(), OUTPUT.cbegin())
                 && s.size() == OUTPUT.size());
 }
+
+TEST(ZippedRange, RandomAccess) {
+    const std::vector<int> integers{ 0, 1, 2, 3, 4 };
+    const std::array<double, 3> reals{ { 0.5, 1.5, 2.5 } };
+    const std::vector<char> chars{ 'a', 'b', 'c', 'd' };
+
+    const auto zipped = umigv::ranges::zip(integers, reals, chars);
+
+    using IteratorT = decltype(zipped.begin());
+
+    static_assert(std::is_same<
+        std::iterator_traits<IteratorT>::iterator_category,
+        std::random_access_iterator_tag
+    >::value, "zipping random access ranges must preserve random access");
+
+    const auto first = zipped.begin();
+    const auto last = zipped.end();
+
+    EXPECT_EQ(last - first, 3);
+    EXPECT_EQ(zipped.size(), 3u);
+    EXPECT_EQ(std::get<2>(first[1]), 'b');
+    EXPECT_EQ(std::get<0>(*(last - 1)), 2);
+    EXPECT_DOUBLE_EQ(std::get<1>(*std::prev(last)), 2.5);
+    EXPECT_TRUE(first < last);
+
+    std::vector<int> reversed;
+
+    for (auto current = last; current != first; --current) {
+        reversed.push_back(std::get<0>(*std::prev(current)));
+    }
+
+    EXPECT_EQ(reversed, (std::vector<int>{ 2, 1, 0 }));
+}
+
+TEST(ZippedRange, Split) {
+    const std::vector<int> v{ 0, 1, 2, 3, 4, 5 };
+    const std::vector<char> u{ 'a', 'b', 'c', 'd' };
+
+    const auto halves = umigv::ranges::zip(v, u).split();
+    const auto second = halves.second.begin();
+
+    EXPECT_EQ(halves.first.size(), 2u);
+    EXPECT_EQ(halves.second.size(), 2u);
+    EXPECT_EQ(std::get<0>(*second), 2);
+    EXPECT_EQ(std::get<1>(*second), 'c');
+}
+
+TEST(ZippedRange, CheckPolicy) {
+    const std::vector<int> v{ 0, 1, 2 };
+    const std::vector<char> u{ 'a', 'b', 'c' };
+
+    const auto unchecked = umigv::ranges::adapt<umigv::ranges::NoChecks>(v)
+        .zip(u);
+    const auto checked = umigv::ranges::zip(v, u);
+
+    static_assert(std::is_same<
+        decltype(unchecked)::check_policy, umigv::ranges::NoChecks
+    >::value, "zip must take the policy of the first range");
+    static_assert(std::is_same<
+        decltype(checked)::check_policy, umigv::ranges::DefaultChecks
+    >::value, "zip must default to DefaultChecks");
+
+    EXPECT_THROW(checked.split_at(4), std::out_of_range);
+}